@@ -0,0 +1,158 @@
+#!/usr/bin/env bash
+# Benchmark the engines over the puzzles and print the results as JSON, to diff them between commits.
+# Every setting is read from the environment (see `make bench`) :
+#   BENCH_ENGINES  engines to run : serial (sudoku-serial.o), openmp (sudoku.o on 1 process), mpi (sudoku.o on local processes)
+#   BENCH_PUZZLES  puzzles to solve, puzzles/ and puzzles_reference/3..10 by default
+#   BENCH_WARMUP   runs of each puzzle not measured
+#   BENCH_REPS     runs of each puzzle measured
+#   BENCH_THREADS  OpenMP threads of each process
+#   BENCH_RANKS    processes of the mpi engine
+#   BENCH_TIMEOUT  seconds before a run is killed and counted as a timeout
+#   BENCH_STATS    1 to count the nodes of sudoku.o with --stats=json, which also times its strategies : without it,
+#                  the nodes and nodes per second are only measured for the serial engine
+#   BENCH_MPIRUN   mpirun command, e.g. "mpirun --oversubscribe"
+#   BENCH_OUTPUT   JSON file written, stdout if empty
+#   SOLVER_OPTIONS options of sudoku.o, e.g. --deterministic for reproducible node counts
+
+BENCH_ENGINES=${BENCH_ENGINES:-"serial openmp mpi"}
+BENCH_PUZZLES=${BENCH_PUZZLES:-"$(ls puzzles/*.txt) $(for i in 3 4 5 6 7 8 9 10; do echo puzzles_reference/$i.txt; done)"}
+BENCH_WARMUP=${BENCH_WARMUP:-1}
+BENCH_REPS=${BENCH_REPS:-5}
+BENCH_THREADS=${BENCH_THREADS:-4}
+BENCH_RANKS=${BENCH_RANKS:-4}
+BENCH_TIMEOUT=${BENCH_TIMEOUT:-60}
+BENCH_STATS=${BENCH_STATS:-0}
+BENCH_MPIRUN=${BENCH_MPIRUN:-mpirun}
+BENCH_OUTPUT=${BENCH_OUTPUT:-}
+
+# the peak resident memory of a run is measured by GNU time when it is installed, the largest process counts
+TIME_COMMAND=()
+[ -x /usr/bin/time ] && /usr/bin/time -f %M true > /dev/null 2>&1 && TIME_COMMAND=(/usr/bin/time -f %M -o)
+
+# run an engine once on a puzzle, print "seconds searchNodes kernelNodes peakMemoryKiB", or "timeout" or "failed",
+# the counts of sudoku.o are "-" without BENCH_STATS, the memory is "-" when neither GNU time nor the engine measure it
+run_once() {
+  local engine=$1 puzzle=$2 output status statsOption="" timeFile="" peakMemory=""
+  [ "$BENCH_STATS" = 1 ] && statsOption="--stats=json"
+  local timer=()
+  if [ ${#TIME_COMMAND[@]} -gt 0 ]; then
+    timeFile=$(mktemp)
+    timer=("${TIME_COMMAND[@]}" "$timeFile")
+  fi
+  case $engine in
+    serial)
+      output=$(timeout -k 5 "$BENCH_TIMEOUT" "${timer[@]}" ./sudoku-serial.o 0 < "$puzzle" 2>&1) ;;
+    openmp)
+      output=$(OMP_NUM_THREADS=$BENCH_THREADS timeout -k 5 "$BENCH_TIMEOUT" "${timer[@]}" $BENCH_MPIRUN -np 1 \
+        -x OMP_NUM_THREADS ./sudoku.o 0 $statsOption $SOLVER_OPTIONS < "$puzzle" 2>&1) ;;
+    mpi)
+      output=$(OMP_NUM_THREADS=$BENCH_THREADS timeout -k 5 "$BENCH_TIMEOUT" "${timer[@]}" $BENCH_MPIRUN -np "$BENCH_RANKS" \
+        -x OMP_NUM_THREADS ./sudoku.o 0 $statsOption $SOLVER_OPTIONS < "$puzzle" 2>&1) ;;
+    *)
+      echo "Unknown engine $engine" >&2
+      exit 1 ;;
+  esac
+  status=$?
+  if [ -n "$timeFile" ]; then
+    # GNU time writes the exit status of a failed command before the measure
+    peakMemory=$(tail -n 1 "$timeFile")
+    rm -f "$timeFile"
+  fi
+  if [ $status -eq 124 ] || [ $status -eq 137 ]; then
+    echo timeout
+    return
+  fi
+
+  if [ "$engine" = serial ]; then
+    echo "$output" | grep -q "Solution for the board" || { echo failed; return; }
+    echo "$output" | awk -F'[=[]' -v peakMemory="$peakMemory" '
+      /Time elapsed = .*\[us\]/ { seconds = $2 / 1000000 }
+      /Search nodes = / { nodes = $2 + 0 }
+      /Peak memory = / { memory = $2 + 0 }
+      END { printf "%.6f %d 0 %d\n", seconds, nodes, peakMemory != "" ? peakMemory : memory }'
+  else
+    echo "$output" | grep -qE "Solution for board|Solution found during first generation" || { echo failed; return; }
+    echo "$output" | awk -v peakMemory="$peakMemory" '
+      BEGIN { nodes = kernelNodes = memory = "-" }
+      /took: / { for (i = 1; i <= NF; ++i) if ($i == "took:") seconds = $(i + 1) }
+      /^\{"processes"/ {
+        match($0, /"nodes":[0-9]+/); nodes = substr($0, RSTART + 8, RLENGTH - 8)
+        match($0, /"kernelNodes":[0-9]+/); kernelNodes = substr($0, RSTART + 14, RLENGTH - 14)
+        match($0, /"peakMemoryKiB":[0-9]+/); memory = substr($0, RSTART + 16, RLENGTH - 16)
+      }
+      END { printf "%.6f %s %s %s\n", seconds, nodes, kernelNodes, peakMemory != "" ? peakMemory : memory }'
+  fi
+}
+
+# summarize the measured runs "seconds searchNodes kernelNodes peakMemoryKiB" read on stdin as JSON fields,
+# p95 is the nearest rank, the counts and the memory are null when they were not measured
+summarize() {
+  sort -g | awk '
+    { seconds[NR] = $1; nodes[NR] = $2; kernelNodes[NR] = $3; memory[NR] = $4
+      rates[NR] = $1 > 0 ? ($2 + $3) / $1 : 0; counted = $2 != "-"; measured = $4 != "-" }
+    function median(values, count,    sorted, i, j, tmp) {
+      for (i = 1; i <= count; ++i) sorted[i] = values[i]
+      for (i = 2; i <= count; ++i) for (j = i; j > 1 && sorted[j - 1] > sorted[j]; --j) {
+        tmp = sorted[j]; sorted[j] = sorted[j - 1]; sorted[j - 1] = tmp
+      }
+      return count % 2 ? sorted[(count + 1) / 2] : (sorted[count / 2] + sorted[count / 2 + 1]) / 2
+    }
+    END {
+      if (NR == 0) {
+        printf "\"medianSeconds\":null,\"p95Seconds\":null,\"searchNodes\":null,\"kernelNodes\":null,"
+        printf "\"nodesPerSecond\":null,\"peakMemoryKiB\":null"
+        exit
+      }
+      p95 = int(0.95 * NR); if (p95 < 0.95 * NR) ++p95
+      printf "\"medianSeconds\":%.6f,\"p95Seconds\":%.6f,", median(seconds, NR), seconds[p95]
+      if (counted) {
+        printf "\"searchNodes\":%d,\"kernelNodes\":%d,", median(nodes, NR), median(kernelNodes, NR)
+        printf "\"nodesPerSecond\":%.0f,", median(rates, NR)
+      } else {
+        printf "\"searchNodes\":null,\"kernelNodes\":null,\"nodesPerSecond\":null,"
+      }
+      printf measured ? "\"peakMemoryKiB\":%d" : "\"peakMemoryKiB\":null", median(memory, NR)
+    }'
+}
+
+results=()
+for engine in $BENCH_ENGINES; do
+  for puzzle in $BENCH_PUZZLES; do
+    for ((run = 0; run < BENCH_WARMUP; ++run)); do
+      run_once "$engine" "$puzzle" > /dev/null
+    done
+    measures=""
+    solved=0
+    timeouts=0
+    failures=0
+    for ((run = 0; run < BENCH_REPS; ++run)); do
+      measure=$(run_once "$engine" "$puzzle")
+      case $measure in
+        timeout) timeouts=$((timeouts + 1)) ;;
+        failed) failures=$((failures + 1)) ;;
+        *) solved=$((solved + 1)); measures+="$measure"$'\n' ;;
+      esac
+    done
+    echo "~> $engine $puzzle : $solved solved, $timeouts timeouts, $failures failures" >&2
+    results+=("{\"engine\":\"$engine\",\"puzzle\":\"$puzzle\",\"solved\":$solved,\"timeouts\":$timeouts,\"failures\":$failures,$(printf "%s" "$measures" | grep . | summarize)}")
+  done
+done
+
+# engines whose search nodes and nodes per second are measured
+countedEngines=""
+for engine in $BENCH_ENGINES; do
+  [ "$engine" = serial ] || [ "$BENCH_STATS" = 1 ] && countedEngines+="${countedEngines:+ }$engine"
+done
+
+json="{\"commit\":\"$(git rev-parse --short HEAD 2>/dev/null)\",\"date\":\"$(date -u +%Y-%m-%dT%H:%M:%SZ)\",\"warmup\":$BENCH_WARMUP,\"repetitions\":$BENCH_REPS,\"threads\":$BENCH_THREADS,\"ranks\":$BENCH_RANKS,\"timeout\":$BENCH_TIMEOUT,\"stats\":$BENCH_STATS,\"countedEngines\":\"$countedEngines\",\"solverOptions\":\"$SOLVER_OPTIONS\",\"results\":["
+for ((i = 0; i < ${#results[@]}; ++i)); do
+  [ $i -gt 0 ] && json+=","
+  json+=$'\n  '"${results[$i]}"
+done
+json+=$'\n]}'
+
+if [ -n "$BENCH_OUTPUT" ]; then
+  echo "$json" > "$BENCH_OUTPUT"
+else
+  echo "$json"
+fi
@@ -5,11 +5,17 @@
 #include <math.h>
 #include <algorithm>
 #include <chrono>
+#include <sys/resource.h>
 #include "sudoku-serial.h"
 static int DEBUG = 0;
 
 static const int DEBUG_BASE = 1;
 
+/**
+ * How many cells have been visited by the search ?
+ */
+static long long searchNodes = 0;
+
 int main(int argc, char *argv[]) {
     if (argc >= 2) {
         DEBUG = std::atoi(argv[1]);
@@ -23,6 +29,10 @@ int main(int argc, char *argv[]) {
     std::cout << "Time elapsed = " << std::chrono::duration_cast<std::chrono::seconds>(end - begin).count() << "[s]" << std::endl;
     std::cout << "Time elapsed = " << std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count() << "[ms]" << std::endl;
     std::cout << "Time elapsed = " << std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count() << "[us]" << std::endl;
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    std::cout << "Search nodes = " << searchNodes << std::endl;
+    std::cout << "Peak memory = " << usage.ru_maxrss << "[KiB]" << std::endl;
 
     if(solution.isEmpty() ) {
         std::cout << "No solution found for this board" << std::endl;
@@ -37,6 +47,7 @@ int main(int argc, char *argv[]) {
 
 // Begin of Solver methods
 SudokuBoard solveBoard(SudokuBoard &board, int row, int col) {
+    ++searchNodes;
     // current cell computed
     const int index = row * board.getRowSize() + col;
 
@@ -7,6 +7,10 @@
 #include <omp.h>
 #include <algorithm>
 #include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <sys/resource.h>
 #include "sudoku.h"
 
 /**
@@ -18,6 +22,301 @@ static int COUNT_PROBLEMS_TO_GENERATE_ON_MASTER = 128;
  */
 static int COUNT_PROBLEMS_TO_GENERATE_ON_WORKER = 32;
 
+/**
+ * The verifier of the boards checks the units in parallel on boards with at least this many rows.
+ */
+static int VERIFY_PARALLEL_MIN_UNITS = 16;
+
+/**
+ * Hit counters of the locked candidates strategy : how many times the strategy has been applied
+ * and how many candidates have been removed by the pointing and claiming rules.
+ */
+static long long lockedCandidatesCalls = 0;
+static long long lockedCandidatesPointingHits = 0;
+static long long lockedCandidatesClaimingHits = 0;
+
+/**
+ * Maximum size of the fish strategy : 2 = X-Wing, 3 = Swordfish, 4 = Jellyfish.
+ * Use a size lower than 2 to disable the strategy.
+ */
+static int FISH_MAX_SIZE = 3;
+/**
+ * Fish strategy is only applied on boards with a dimension (N) greater or equal to this threshold.
+ */
+static int FISH_MIN_SUDOKU_DIMENSION = 6;
+
+/**
+ * All-different strategy is applied before branching on boards with a dimension (N)
+ * greater or equal to this threshold, use 0 to disable it.
+ */
+static int ALL_DIFFERENT_MIN_SUDOKU_DIMENSION = 8;
+
+/**
+ * Counters of the all-different strategy.
+ */
+static long long allDifferentCalls = 0;
+static long long allDifferentHits = 0;
+
+/**
+ * Branching used by solveBoard : always a cell, or a value in a unit when it has less alternatives.
+ */
+static int BRANCHING_POLICY = BRANCHING_UNIT;
+
+/**
+ * Order of the alternatives explored by solveBoard : natural, least constraining value first
+ * or value with less dead-ends first.
+ */
+static int VALUE_ORDER = VALUE_ORDER_NATURAL;
+
+/**
+ * Dead-ends encountered by each thread for each assignment, used by the history value ordering.
+ * valueOrderHistories[thread][(row * N^2 + col) * (N^2 + 1) + value]
+ */
+static std::vector<std::vector<int>> valueOrderHistories;
+
+/**
+ * How many nodes have been explored by solveBoard ?
+ */
+static long long searchNodes = 0;
+
+/**
+ * Count of nodes explored by a task between two checks for idle threads, the search
+ * is split when no task is waiting. 0 disables the split.
+ */
+static long long SEARCH_SPLIT_PERIOD = 64;
+
+/**
+ * How many times a search has been split ?
+ */
+static long long searchSplits = 0;
+
+/**
+ * Traversal of the search trees by the worker threads : depth-first, limited discrepancy search,
+ * or limited discrepancy search with the discrepancy limits distributed between the threads.
+ */
+static int TREE_SEARCH = TREE_SEARCH_DFS;
+
+/**
+ * Boards with less empty cells than this percentage of their cells are handed off to the bitmask kernel,
+ * and boards with less than twice the percentage if their propagation did not set any cell. 0 disables the kernel.
+ * The threshold scales with the board so that only the nodes near the leaves skip the strategies.
+ */
+static int KERNEL_THRESHOLD = 10;
+
+/**
+ * Bitmask kernel of each thread.
+ */
+static std::vector<BitmaskKernel> bitmaskKernels;
+
+/**
+ * How many boards have been handed off to the kernel, and how many of them have been solved ?
+ */
+static long long kernelHandoffs = 0;
+static long long kernelSolutions = 0;
+
+/**
+ * Policy of the frontier generation on the master and the workers : breadth-first, or the largest board first.
+ */
+static int FRONTIER_POLICY = FRONTIER_FIFO;
+
+/**
+ * Order of the problems dispatched to the workers and to the threads : generation order,
+ * or the longest expected first.
+ */
+static int DISPATCH_ORDER = DISPATCH_ORDER_FIFO;
+
+/**
+ * How many random walks are averaged by the probe estimate of the cost of a board ?
+ */
+static int COST_PROBES = 8;
+
+/**
+ * Problem boards are sent to the idle workers during the generation on the master once it holds
+ * this many boards, smaller boards would unbalance the workers. 0 waits for the end of the generation.
+ */
+static int STREAM_MIN_BOARDS = 32;
+
+/**
+ * Deterministic mode : the k-th problem board of the master goes to the worker 1 + k % (count of workers),
+ * the threads search the sub-problems without splitting them and the solution of the lowest index wins,
+ * the options relying on the timing of the threads (shared tables, history, adaptive scheduler) are disabled.
+ */
+static bool DETERMINISTIC = false;
+
+/**
+ * Boards of the frontier expanded at once by the threads of the master in deterministic mode,
+ * the problem boards don't depend on the count of threads.
+ */
+static int DETERMINISTIC_EXPANSION_BATCH = 8;
+
+/**
+ * Search nodes of the problems up to the winning one (all of them without solution) in deterministic mode,
+ * the nodes explored in the problems after the winning one are not counted, so it is identical across runs.
+ */
+static long long orderedSearchNodes = 0;
+
+/**
+ * How many iterations of limited discrepancy search have been run ?
+ */
+static long long discrepancyIterations = 0;
+
+/**
+ * Count mode : count the solutions up to this limit instead of stopping at the first one,
+ * -1 counts all the solutions, 0 disables the count mode.
+ */
+static long long COUNT_SOLUTIONS_LIMIT = 0;
+
+/**
+ * Budgets of each process : wall time in seconds since the start of the run, search nodes explored
+ * and peak resident memory in MiB, 0 for no limit. Once a budget is exhausted the searches stop
+ * and the best partial board is reported instead of a solution.
+ */
+static double TIME_BUDGET = 0;
+static long long NODE_BUDGET = 0;
+static long long MEMORY_BUDGET = 0;
+
+/**
+ * Nodes explored by a search, or rounds of the strategies of a propagation, between two checks of the budgets.
+ */
+static long long BUDGET_CHECK_PERIOD = 16;
+
+/**
+ * Nodes explored by a bitmask kernel between two checks of the budgets.
+ */
+static long long KERNEL_BUDGET_CHECK_PERIOD = 4096;
+
+/**
+ * Start of the time budget, and the budget exhausted on this process.
+ */
+static double budgetStart = 0;
+static int exhaustedBudget = BUDGET_NONE;
+
+/**
+ * Board with the most solved cells after propagation met on this process while a budget is set.
+ */
+static SudokuBoard bestPartialBoard(0);
+static int bestPartialSolvedCells = -1;
+
+/**
+ * Statistics of the run summed over the threads and the processes, printed by the master as a table or as JSON.
+ */
+static int STATS_OUTPUT = STATS_OFF;
+
+/**
+ * Statistics of the searches of each thread.
+ */
+static std::vector<SearchStatistics> searchStatistics;
+
+/**
+ * Workers poll the stop requests of the master during their searches when they do not count the solutions,
+ * the searches of a solved run end without waiting for the abort of the master.
+ */
+static bool pollStopWork = false;
+static bool stopWorkReceived = false;
+
+/**
+ * Microseconds between two polls of the stop requests by the main thread while the other threads search.
+ */
+static int STOP_WORK_POLL_MICROSECONDS = 1000;
+
+/**
+ * Prefix of the binary trace files of the searches, one by process and thread, empty to trace nothing.
+ */
+static std::string TRACE_PREFIX;
+
+/**
+ * Trace file replayed instead of solving the board, and index of the record of the node to replay,
+ * -1 for the heaviest subtree of the trace.
+ */
+static std::string REPLAY_FILE;
+static long long REPLAY_RECORD = -1;
+
+/**
+ * Trace file and count of searches traced of each thread.
+ */
+static std::vector<std::unique_ptr<std::ofstream>> traceFiles;
+static std::vector<int> tracedSearches;
+
+/**
+ * Search mode : split the board between the workers or race a portfolio of searches.
+ */
+static int SEARCH_MODE = SEARCH_SPLIT;
+
+/**
+ * Seed of the randomized members of the portfolio.
+ */
+static unsigned long long PORTFOLIO_SEED = 0;
+
+/**
+ * Nodes explored by a randomized member of the portfolio before its first restart,
+ * the following limits follow the Luby sequence.
+ */
+static long long PORTFOLIO_RESTART_BASE = 128;
+
+/**
+ * Nodes explored by a member of the portfolio between two checks of the stop messages.
+ */
+static long long PORTFOLIO_POLL_PERIOD = 64;
+
+/**
+ * How many times the members of the portfolio have been restarted ?
+ */
+static long long portfolioRestarts = 0;
+
+/**
+ * Search variant of each thread.
+ */
+static std::vector<SearchVariant> searchVariants;
+
+/**
+ * Tables of boards proven without solution : none, one by thread, or one by thread plus a table shared by the threads.
+ */
+static int TRANSPOSITION_POLICY = TRANSPOSITION_SHARED;
+
+/**
+ * Size (log2) of the table of each thread and of the shared table.
+ */
+static int TRANSPOSITION_TABLE_BITS = 16;
+static int SHARED_TRANSPOSITION_TABLE_BITS = 20;
+
+/**
+ * Tables of boards proven without solution of each thread.
+ */
+static std::vector<DeadStateTable> deadStateTables;
+
+/**
+ * Table of boards proven without solution shared by the threads, written and read without lock.
+ */
+static std::unique_ptr<std::atomic<std::uint64_t>[]> sharedDeadStates;
+
+/**
+ * How many boards have been pruned or saved by the tables ?
+ */
+static long long deadStateHits = 0;
+static long long deadStateRecords = 0;
+
+/**
+ * Use the adaptive scheduling of strategies ? Otherwise strategies are applied in a fixed order.
+ */
+static bool ADAPTIVE_SCHEDULER = true;
+/**
+ * How many consecutive calls without change before skipping a strategy ?
+ */
+static int SCHEDULER_BACKOFF_FAILURES = 8;
+/**
+ * Maximum backoff level : a strategy is skipped at most 2^level times in a row.
+ */
+static int SCHEDULER_MAX_BACKOFF = 6;
+/**
+ * How many passes between two reordering of the strategies ?
+ */
+static int SCHEDULER_REORDER_PERIOD = 256;
+
+/**
+ * Strategy schedulers of each thread, indexed by the dimension of the boards.
+ */
+static std::vector<std::map<int, StrategyScheduler>> strategySchedulers;
+
 static int DEBUG = 0;
 
 static const int DEBUG_BASE = 1;
@@ -29,9 +328,29 @@ int main(int argc, char *argv[]) {
     if (argc >= 2) {
         DEBUG = std::atoi(argv[1]);
     }
+    parseSolverOptions(argc, argv, 2);
+    strategySchedulers.resize(omp_get_max_threads());
+    valueOrderHistories.resize(omp_get_max_threads());
+    bitmaskKernels.resize(omp_get_max_threads());
+    searchVariants.resize(omp_get_max_threads());
+    searchStatistics.resize(omp_get_max_threads());
+    for (auto &variant: searchVariants) {
+        variant.valueOrder = VALUE_ORDER;
+    }
+    if (TRANSPOSITION_POLICY != TRANSPOSITION_OFF) {
+        deadStateTables.assign(omp_get_max_threads(), DeadStateTable(TRANSPOSITION_TABLE_BITS));
+    }
+    if (TRANSPOSITION_POLICY == TRANSPOSITION_SHARED) {
+        const std::size_t sharedSize = std::size_t(1) << SHARED_TRANSPOSITION_TABLE_BITS;
+        sharedDeadStates.reset(new std::atomic<std::uint64_t>[sharedSize]);
+        for (std::size_t i = 0; i < sharedSize; ++i) {
+            sharedDeadStates[i].store(0, std::memory_order_relaxed);
+        }
+    }
 
-    // Initialize MPI
-    MPI_Init(&argc, &argv);
+    // Initialize MPI, only the main thread of a process exchanges messages
+    int threadSupport;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &threadSupport);
     MPI_Comm_rank(MPI_COMM_WORLD, &processId);
     MPI_Comm_size(MPI_COMM_WORLD, &countProcess);
 
@@ -39,6 +358,18 @@ int main(int argc, char *argv[]) {
         std::cout << "[" << processId << "]: DEBUG LEVEL = " << DEBUG << std::endl;
     }
 
+    if (!REPLAY_FILE.empty()) {
+        // performance debugging of a traced search, no board to solve
+        if (processId == 0) {
+            replayTrace(REPLAY_FILE, REPLAY_RECORD);
+        }
+        MPI_Finalize();
+        return 0;
+    }
+    if (!TRACE_PREFIX.empty()) {
+        openTraceFiles(TRACE_PREFIX, processId);
+    }
+
 #pragma omp parallel
     {
 #pragma omp single
@@ -60,6 +391,105 @@ int main(int argc, char *argv[]) {
     return 0;
 }
 
+void parseSolverOptions(int argc, char *argv[], int firstOption) {
+    for (int i = firstOption; i < argc; ++i) {
+        const std::string option(argv[i]);
+        const std::size_t separator = option.find('=');
+        const std::string name = option.substr(0, separator);
+        const std::string value = separator == std::string::npos ? "" : option.substr(separator + 1);
+
+        if (name == "--fish-size") {
+            FISH_MAX_SIZE = std::atoi(value.c_str());
+        } else if (name == "--fish-min-dimension") {
+            FISH_MIN_SUDOKU_DIMENSION = std::atoi(value.c_str());
+        } else if (name == "--all-different-min-dimension") {
+            ALL_DIFFERENT_MIN_SUDOKU_DIMENSION = std::atoi(value.c_str());
+        } else if (name == "--branching") {
+            BRANCHING_POLICY = value == "cell" ? BRANCHING_CELL : BRANCHING_UNIT;
+        } else if (name == "--value-order") {
+            VALUE_ORDER = value == "lcv" ? VALUE_ORDER_LCV : value == "history" ? VALUE_ORDER_HISTORY
+                                                                                : VALUE_ORDER_NATURAL;
+        } else if (name == "--split-period") {
+            SEARCH_SPLIT_PERIOD = std::atoll(value.c_str());
+        } else if (name == "--search") {
+            SEARCH_MODE = value == "portfolio" ? SEARCH_PORTFOLIO : SEARCH_SPLIT;
+        } else if (name == "--portfolio-seed") {
+            PORTFOLIO_SEED = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (name == "--restart-base") {
+            PORTFOLIO_RESTART_BASE = std::atoll(value.c_str());
+        } else if (name == "--transposition") {
+            TRANSPOSITION_POLICY = value == "off" ? TRANSPOSITION_OFF : value == "thread" ? TRANSPOSITION_THREAD
+                                                                                          : TRANSPOSITION_SHARED;
+        } else if (name == "--transposition-bits") {
+            TRANSPOSITION_TABLE_BITS = std::atoi(value.c_str());
+        } else if (name == "--shared-transposition-bits") {
+            SHARED_TRANSPOSITION_TABLE_BITS = std::atoi(value.c_str());
+        } else if (name == "--tree-search") {
+            TREE_SEARCH = value == "lds" ? TREE_SEARCH_LDS : value == "lds-parallel" ? TREE_SEARCH_LDS_PARALLEL
+                                                                                      : TREE_SEARCH_DFS;
+        } else if (name == "--kernel-threshold") {
+            KERNEL_THRESHOLD = std::atoi(value.c_str());
+        } else if (name == "--frontier") {
+            FRONTIER_POLICY = value == "empty-cells" ? FRONTIER_EMPTY_CELLS : value == "log-product"
+                                                                              ? FRONTIER_LOG_PRODUCT : FRONTIER_FIFO;
+        } else if (name == "--dispatch-order") {
+            DISPATCH_ORDER = value == "log-product" ? DISPATCH_ORDER_LOG_PRODUCT : value == "probe"
+                                                                                   ? DISPATCH_ORDER_PROBE
+                                                                                   : DISPATCH_ORDER_FIFO;
+        } else if (name == "--cost-probes") {
+            COST_PROBES = std::max(1, std::atoi(value.c_str()));
+        } else if (name == "--stream-min-boards") {
+            STREAM_MIN_BOARDS = std::atoi(value.c_str());
+        } else if (name == "--time-budget") {
+            TIME_BUDGET = std::atof(value.c_str());
+        } else if (name == "--node-budget") {
+            NODE_BUDGET = std::atoll(value.c_str());
+        } else if (name == "--memory-budget") {
+            MEMORY_BUDGET = std::atoll(value.c_str());
+        } else if (name == "--count") {
+            COUNT_SOLUTIONS_LIMIT = value == "all" ? -1 : std::atoll(value.c_str());
+        } else if (name == "--scheduler") {
+            ADAPTIVE_SCHEDULER = value != "fixed";
+        } else if (name == "--deterministic") {
+            DETERMINISTIC = value != "off";
+        } else if (name == "--stats") {
+            STATS_OUTPUT = value == "off" ? STATS_OFF : value == "json" ? STATS_JSON : STATS_TABLE;
+        } else if (name == "--trace") {
+            TRACE_PREFIX = value;
+        } else if (name == "--replay") {
+            REPLAY_FILE = value;
+        } else if (name == "--replay-node") {
+            REPLAY_RECORD = std::atoll(value.c_str());
+        } else {
+            std::cerr << "Unknown option " << option << ", ignored." << std::endl;
+        }
+    }
+
+    if (COUNT_SOLUTIONS_LIMIT != 0 && SEARCH_MODE == SEARCH_PORTFOLIO) {
+        std::cerr << "The count mode explores the whole search tree, the portfolio search is disabled." << std::endl;
+        SEARCH_MODE = SEARCH_SPLIT;
+    }
+    if (COUNT_SOLUTIONS_LIMIT != 0 && TREE_SEARCH != TREE_SEARCH_DFS) {
+        std::cerr << "The count mode explores the whole search tree, depth-first search is used." << std::endl;
+        TREE_SEARCH = TREE_SEARCH_DFS;
+    }
+    if (DETERMINISTIC) {
+        if (SEARCH_MODE == SEARCH_PORTFOLIO || TREE_SEARCH == TREE_SEARCH_LDS_PARALLEL ||
+            VALUE_ORDER == VALUE_ORDER_HISTORY) {
+            std::cerr << "The deterministic mode races no search, the board is split and searched with the natural "
+                         "or lcv value order." << std::endl;
+        }
+        SEARCH_MODE = SEARCH_SPLIT;
+        TREE_SEARCH = TREE_SEARCH == TREE_SEARCH_LDS_PARALLEL ? TREE_SEARCH_LDS : TREE_SEARCH;
+        VALUE_ORDER = VALUE_ORDER == VALUE_ORDER_HISTORY ? VALUE_ORDER_NATURAL : VALUE_ORDER;
+        // the results of these ones depend on which thread searched what before
+        TRANSPOSITION_POLICY = TRANSPOSITION_OFF;
+        ADAPTIVE_SCHEDULER = false;
+        SEARCH_SPLIT_PERIOD = 0;
+        STREAM_MIN_BOARDS = 0;
+    }
+}
+
 void initSolveMPI() {
     int processId;                              /* Process rank */
     int countProcess;                           /* Number of processes */
@@ -75,6 +505,153 @@ void initSolveMPI() {
 
     // exec timing
     double p1Time = -MPI_Wtime();
+    startBudget();
+    // budget exhausted on the processes and search nodes explored, known by the master at the end of the run
+    int budgetOnRun = BUDGET_NONE;
+    long long nodesOnRun = 0;
+
+    // count mode : solutions counted on the master and reported by each worker
+    const bool countMode = COUNT_SOLUTIONS_LIMIT != 0;
+    SolutionCounter masterCounter(COUNT_SOLUTIONS_LIMIT);
+    std::vector<long long> countSolutionsReportedByWorkers(countProcess - 1, 0);
+
+    // the worker who found the solution
+    int firstWinnerWorker = -1;
+    // balance load dynamically between processes
+    int successWorkerId = -1;
+
+    // master process opens idle requests from workers, the problem boards are streamed
+    // to the idle workers while the master is still generating them
+    const bool dispatchToWorkers = processId == 0 && SEARCH_MODE == SEARCH_SPLIT && countProcess > 1;
+    std::vector<MPI_Request> workersRequests(countProcess - 1);
+    std::vector<long long> countSolutionsFoundOnProcess(countProcess - 1, 0);
+    int countDispatchedBoards = 0;
+    if (dispatchToWorkers) {
+        for (int workerId = 1; workerId < countProcess; ++workerId) {
+            MPI_Irecv(countSolutionsFoundOnProcess.data() + workerId - 1, 1, MPI_LONG_LONG, workerId, CUSTOM_MPI_IDLE_TAG,
+                      MPI_COMM_WORLD, (workersRequests.data() + workerId - 1));
+        }
+    }
+
+    // send a problem board to each idle worker, the remaining boards are removed when a worker
+    // has found a solution or when the count limit is reached
+    auto dispatchToIdleWorkers = [&]() {
+        MPI_Status idleRequestStatus;
+        // an empty batch would stop the worker
+        for (int workerId = 1; workerId < countProcess && !problemBoards.empty(); ++workerId) {
+            int idleResponse = 0;
+            // check if the request has been completed
+            MPI_Test((workersRequests.data() + workerId - 1), &idleResponse, &idleRequestStatus);
+            if (!idleResponse) {
+                continue;
+            }
+
+            // worker is idle ! send it some work
+            // workers report their count of solutions in count mode
+            countSolutionsReportedByWorkers[workerId - 1] = countSolutionsFoundOnProcess[workerId - 1];
+            long long countSolutions = masterCounter.total();
+            for (long long reportedCount: countSolutionsReportedByWorkers) {
+                countSolutions += reportedCount;
+            }
+
+            if (countMode && COUNT_SOLUTIONS_LIMIT > 0 && countSolutions >= COUNT_SOLUTIONS_LIMIT) {
+                // limit reached, remove remaining problem boards
+                std::deque<SudokuBoard> empty;
+                std::swap(problemBoards, empty);
+                return;
+            }
+            // check if the worker has finished ?
+            if (!countMode && countSolutionsFoundOnProcess[workerId - 1] > 0) {
+                // a worker has found a solution, remove remaining problem boards
+                successWorkerId = workerId;
+                std::cout << "[" << processId << "]: " << workerId << " just found a solution !" << std::endl;
+                // empty working queue then finish
+                std::deque<SudokuBoard> empty;
+                std::swap(problemBoards, empty);
+                return;
+            }
+
+            // otherwise, send it some work
+            if (DEBUG >= DEBUG_BASE) {
+                std::cout << "[" << processId << "]: sending 1 problem board to process[" << workerId << "]"
+                          << std::endl;
+            }
+            std::cout << "\r[" << processId << "]: Dispatching ";
+            std::cout << countDispatchedBoards << "/" << countDispatchedBoards + problemBoards.size()
+                      << std::flush;
+            std::cout << " problems boards between workers.";
+
+            std::deque<SudokuBoard> sentBoards;
+            sentBoards.emplace_back(popFrontierBoard(problemBoards));
+            sendAndConsumeDeque(sentBoards, workerId, CUSTOM_MPI_POSSIBILITIES_TAG, MPI_COMM_WORLD, 1);
+            countDispatchedBoards += 1;
+            MPI_Irecv(countSolutionsFoundOnProcess.data() + workerId - 1, 1, MPI_LONG_LONG, workerId,
+                      CUSTOM_MPI_IDLE_TAG, MPI_COMM_WORLD,
+                      (workersRequests.data() + workerId - 1));
+        }
+    };
+
+    // deterministic mode : the k-th problem board is searched by the worker 1 + k % (countProcess - 1),
+    // the solution of the lowest board index wins, workers report their ordered search nodes after each board
+    std::vector<int> boardOfWorker(countProcess - 1, -1);
+    std::vector<long long> orderedNodesOfWorker(countProcess - 1, 0);
+    std::vector<long long> orderedNodesOfBoard;
+    int winningBoard = -1;
+    auto collectWorkerReport = [&](int workerIndex) {
+        MPI_Wait(workersRequests.data() + workerIndex, MPI_STATUS_IGNORE);
+        const int board = boardOfWorker[workerIndex];
+        if (board == -1) {
+            return;
+        }
+        boardOfWorker[workerIndex] = -1;
+        long long orderedNodes;
+        MPI_Recv(&orderedNodes, 1, MPI_LONG_LONG, workerIndex + 1, CUSTOM_MPI_REPORT_TAG, MPI_COMM_WORLD,
+                 MPI_STATUS_IGNORE);
+        orderedNodesOfBoard[board] = orderedNodes - orderedNodesOfWorker[workerIndex];
+        orderedNodesOfWorker[workerIndex] = orderedNodes;
+        countSolutionsReportedByWorkers[workerIndex] = countSolutionsFoundOnProcess[workerIndex];
+        if (!countMode && countSolutionsFoundOnProcess[workerIndex] > 0 &&
+            (winningBoard == -1 || board < winningBoard)) {
+            winningBoard = board;
+            successWorkerId = workerIndex + 1;
+        }
+    };
+    auto dispatchInOrder = [&]() {
+        orderedNodesOfBoard.assign(problemBoards.size(), 0);
+        for (int board = 0; !problemBoards.empty() && checkBudget() == BUDGET_NONE; ++board) {
+            const int workerIndex = board % (countProcess - 1);
+            collectWorkerReport(workerIndex);
+            long long countSolutions = masterCounter.total();
+            for (long long reportedCount: countSolutionsReportedByWorkers) {
+                countSolutions += reportedCount;
+            }
+            if ((winningBoard != -1 && board > winningBoard) ||
+                (countMode && COUNT_SOLUTIONS_LIMIT > 0 && countSolutions >= COUNT_SOLUTIONS_LIMIT)) {
+                // the next boards can't win
+                break;
+            }
+
+            std::cout << "\r[" << processId << "]: Dispatching " << board << "/" << orderedNodesOfBoard.size()
+                      << " problems boards between workers." << std::flush;
+            std::deque<SudokuBoard> sentBoards;
+            sentBoards.emplace_back(popFrontierBoard(problemBoards));
+            sendAndConsumeDeque(sentBoards, workerIndex + 1, CUSTOM_MPI_POSSIBILITIES_TAG, MPI_COMM_WORLD, 1);
+            boardOfWorker[workerIndex] = board;
+            countDispatchedBoards += 1;
+            MPI_Irecv(countSolutionsFoundOnProcess.data() + workerIndex, 1, MPI_LONG_LONG, workerIndex + 1,
+                      CUSTOM_MPI_IDLE_TAG, MPI_COMM_WORLD, (workersRequests.data() + workerIndex));
+        }
+        std::deque<SudokuBoard> empty;
+        std::swap(problemBoards, empty);
+
+        // the boards before the winning one must be searched until the end
+        for (int workerIndex = 0; workerIndex < countProcess - 1; ++workerIndex) {
+            if (boardOfWorker[workerIndex] != -1 &&
+                (winningBoard == -1 || boardOfWorker[workerIndex] < winningBoard)) {
+                collectWorkerReport(workerIndex);
+            }
+        }
+    };
 
     // init sudoku solving on master
     // compute first boards to investigate
@@ -85,21 +662,48 @@ void initSolveMPI() {
                   << sudoku.getColumnSize() << "x" << sudoku.getRowSize() << " to solve : " << std::endl << sudoku
                   << std::endl;
 
-        // generate the first sub-problems in order to dispatch work between nodes
+        BoardConflict inputConflict;
+        if (sudoku.findFirstConflict(inputConflict)) {
+            // the search will end without solution
+            std::cerr << "[" << processId << "]: The board to solve is invalid, " << inputConflict << "." << std::endl;
+        }
+
+        // generate the first sub-problems in order to dispatch work between nodes,
+        // the threads expand several boards at once
         problemBoards.emplace_front(std::move(sudoku));
         problemBoards.front().recountSolvedCells();
         problemBoards.front().computePossiblesValuesInCells();
-        while (!problemBoards.empty() && problemBoards.size() < COUNT_PROBLEMS_TO_GENERATE_ON_MASTER) {
-            SudokuBoard solution = generatePossibilitiesNextCell(problemBoards);
+        recordPartialBoard(problemBoards.front());
+        bool generationStopped = false;
+        while (SEARCH_MODE == SEARCH_SPLIT && !generationStopped && !problemBoards.empty() &&
+               (int) problemBoards.size() < COUNT_PROBLEMS_TO_GENERATE_ON_MASTER && checkBudget() == BUDGET_NONE) {
+            std::vector<SudokuBoard> solutions = generatePossibilitiesInParallel(
+                    problemBoards, DETERMINISTIC ? DETERMINISTIC_EXPANSION_BATCH : omp_get_max_threads());
+
+            for (auto &solution: solutions) {
+                if (countMode) {
+                    // count it and go on, unless the limit is reached
+                    bool limitReached = false;
+                    countSolution(solution, limitReached, solutionBoards, masterCounter);
+                    generationStopped = limitReached;
+                } else {
+                    // solution found, end of generation
+                    solutionBoards.emplace_back(std::move(solution));
+                    generationStopped = true;
+                }
+                if (generationStopped) {
+                    break;
+                }
+            }
 
-            if (!solution.isEmpty()) {
-                // solution found, end of generation
-                solutionBoards.emplace_back(std::move(solution));
-                break;
+            // idle workers don't wait for the end of the generation
+            if (!generationStopped && dispatchToWorkers && STREAM_MIN_BOARDS > 0 &&
+                (int) problemBoards.size() >= STREAM_MIN_BOARDS) {
+                dispatchToIdleWorkers();
             }
         }
 
-        if (!solutionBoards.empty()) {
+        if (!solutionBoards.empty() && (!countMode || masterCounter.isLimitReached())) {
             std::cout << "[" << processId << "]: Solution found during first generation :" << std::endl
                       << solutionBoards.front()
                       << std::endl;
@@ -107,99 +711,177 @@ void initSolveMPI() {
             std::swap(problemBoards, empty);
         }
 
+        if (SEARCH_MODE == SEARCH_SPLIT) {
+            // dispatch the longest expected problems first, the shortest ones fill the end of the run
+            orderByExpectedCost(problemBoards);
+        }
+
         std::cout << "[" << processId << "]: Generated " << problemBoards.size()
-                  << " initial problem boards to dispatch between workers."
-                  << std::endl;
+                  << " initial problem boards to dispatch between workers";
+        if (countDispatchedBoards > 0) {
+            std::cout << ", " << countDispatchedBoards << " boards already dispatched during the generation";
+        }
+        std::cout << "." << std::endl;
     }
 
-    // the worker who found the solution
-    int firstWinnerWorker = -1;
-    // balance load dynamically between processes
-    int successWorkerId = -1;
-    if (processId == 0) {
-        MPI_Status idleRequestStatus;
-        // master process opens idle requests from workers
-        std::vector<MPI_Request> workersRequests(countProcess - 1);
-        std::vector<int> countSolutionsFoundOnProcess(countProcess - 1, 0);
-        for (int workerId = 1; workerId < countProcess; ++workerId) {
-            MPI_Irecv(countSolutionsFoundOnProcess.data() + workerId - 1, 1, MPI_INT, workerId, CUSTOM_MPI_IDLE_TAG,
-                      MPI_COMM_WORLD, (workersRequests.data() + workerId - 1));
+    if (SEARCH_MODE == SEARCH_PORTFOLIO) {
+        dispatchPortfolio(problemBoards, solutionBoards, successWorkerId, firstWinnerWorker);
+    } else if (processId == 0 && countProcess == 1) {
+        // no worker, count or solve locally with the threads of the master
+        if (!problemBoards.empty()) {
+            bool stopped = false;
+            SolverContext context(stopped);
+            if (solveProblemsOnNode(problemBoards, countMode ? &masterCounter : nullptr, context) == SOLVER_SOLVED &&
+                solutionBoards.empty()) {
+                solutionBoards.emplace_back(std::move(context.solution));
+                if (!countMode) {
+                    successWorkerId = processId;
+                    firstWinnerWorker = processId;
+                }
+            }
+        }
+    } else if (processId == 0) {
+        if (DETERMINISTIC) {
+            dispatchInOrder();
         }
-
         // distribute work, iterate over each process worker until no work left
-        int idleResponse;
-        const int initialProblemsSize = problemBoards.size();
         while (!problemBoards.empty()) {
-            for (int workerId = 1; workerId < countProcess; ++workerId) {
-                idleResponse = 0;
-                // check if the request has been completed
-                MPI_Test((workersRequests.data() + workerId - 1), &idleResponse, &idleRequestStatus);
-
-                // worker is idle ! send it some work
-                if (idleResponse) {
-                    // check if the worker has finished ?
-                    if (countSolutionsFoundOnProcess[workerId - 1] > 0) {
-                        // a worker has found a solution, remove remaining problem boards
-                        successWorkerId = workerId;
-                        std::cout << "[" << processId << "]: " << workerId << " just found a solution !" << std::endl;
-                        // empty working queue then finish
-                        std::deque<SudokuBoard> empty;
-                        std::swap(problemBoards, empty);
-                        break;
-                    } else {
-                        // otherwise, send it some work
-                        if (DEBUG >= DEBUG_BASE) {
-                            std::cout << "[" << processId << "]: sending 1 problem board to process[" << workerId << "]"
-                                      << std::endl;
-                        }
-                        std::cout << "\r[" << processId << "]: Dispatching ";
-                        std::cout << initialProblemsSize - problemBoards.size() << "/" << initialProblemsSize
-                                  << std::flush;
-                        std::cout << " problems boards between workers.";
-
-                        sendAndConsumeDeque(problemBoards, workerId, CUSTOM_MPI_POSSIBILITIES_TAG, MPI_COMM_WORLD, 1);
-                        MPI_Irecv(countSolutionsFoundOnProcess.data() + workerId - 1, 1, MPI_INT, workerId,
-                                  CUSTOM_MPI_IDLE_TAG, MPI_COMM_WORLD,
-                                  (workersRequests.data() + workerId - 1));
-                    }
-                }
+            if (checkBudget() != BUDGET_NONE) {
+                // budget exhausted, the remaining problem boards won't be searched
+                std::deque<SudokuBoard> empty;
+                std::swap(problemBoards, empty);
+                break;
             }
+            dispatchToIdleWorkers();
         }
         std::cout << "... finished!" << std::endl;
 
-        if (DEBUG >= DEBUG_BASE) {
-            std::cout << "[" << processId << "]: all problem boards have been computed!" << std::endl;
+        // the last boards may still be searched, wait for the reports of the workers
+        while (!countMode && successWorkerId == -1 && solutionBoards.empty()) {
+            int workerIndex;
+            MPI_Waitany(countProcess - 1, workersRequests.data(), &workerIndex, MPI_STATUS_IGNORE);
+            if (workerIndex == MPI_UNDEFINED) {
+                // every worker is idle
+                break;
+            }
+            if (countSolutionsFoundOnProcess[workerIndex] > 0) {
+                successWorkerId = workerIndex + 1;
+                std::cout << "[" << processId << "]: " << successWorkerId << " just found a solution !" << std::endl;
+            }
         }
-    } else {
-        unsigned int processLoad = 0;
-        // workers wait for work to do while the working queue is not empty
-        MPI_Request workerRequestIdle;
-        MPI_Status idleRequestStatus;
-        do {
-            // notice master process is idle
-            // send to master the number of solutions founds
-            int countSolutions = solutionBoards.size();
-            MPI_Isend(&countSolutions, 1, MPI_INT, 0, CUSTOM_MPI_IDLE_TAG, MPI_COMM_WORLD, &workerRequestIdle);
-            MPI_Wait(&workerRequestIdle, &idleRequestStatus);
 
-            // wait work from master
-            int countReceivedBoards = receivePushBackDeque(problemBoards, 0, CUSTOM_MPI_POSSIBILITIES_TAG,
+        bool workersStopped = false;
+        if (!countMode && isBudgetSet() && successWorkerId == -1 && solutionBoards.empty()) {
+            // no solution within the budgets and every worker is idle : stop them, they report their best partial board
+            workersStopped = true;
+            std::deque<SudokuBoard> noWork;
+            for (int workerId = 1; workerId < countProcess; ++workerId) {
+                sendAndConsumeDeque(noWork, workerId, CUSTOM_MPI_POSSIBILITIES_TAG, MPI_COMM_WORLD, 0);
+            }
+            for (int workerId = 1; workerId < countProcess; ++workerId) {
+                long long report[2];
+                MPI_Recv(report, 2, MPI_LONG_LONG, workerId, CUSTOM_MPI_PARTIAL_TAG, MPI_COMM_WORLD,
+                         MPI_STATUS_IGNORE);
+                if (budgetOnRun == BUDGET_NONE) {
+                    budgetOnRun = (int) report[0];
+                }
+                nodesOnRun += report[1];
+                SudokuBoard partialBoard = receiveSudokuBoard(workerId, CUSTOM_MPI_PARTIAL_TAG, MPI_COMM_WORLD);
+                if (!partialBoard.isEmpty()) {
+                    partialBoard.recountSolvedCells();
+                    recordPartialBoard(partialBoard);
+                }
+            }
+        }
+
+        if (!countMode && !workersStopped) {
+            // stop the searches of the workers, then their work
+            std::deque<SudokuBoard> noWork;
+            int stop = 0;
+            for (int workerId = 1; workerId < countProcess; ++workerId) {
+                if (workerId != successWorkerId) {
+                    MPI_Send(&stop, 1, MPI_INT, workerId, CUSTOM_MPI_STOP_WORK_TAG, MPI_COMM_WORLD);
+                    sendAndConsumeDeque(noWork, workerId, CUSTOM_MPI_POSSIBILITIES_TAG, MPI_COMM_WORLD, 0);
+                }
+            }
+        }
+
+        if (countMode) {
+            // wait the last reports of the workers, then stop them
+            MPI_Waitall(countProcess - 1, workersRequests.data(), MPI_STATUSES_IGNORE);
+            std::deque<SudokuBoard> noWork;
+            for (int workerId = 1; workerId < countProcess; ++workerId) {
+                countSolutionsReportedByWorkers[workerId - 1] = countSolutionsFoundOnProcess[workerId - 1];
+                sendAndConsumeDeque(noWork, workerId, CUSTOM_MPI_POSSIBILITIES_TAG, MPI_COMM_WORLD, 0);
+            }
+
+            // a worker sends one of its solutions if the master has none
+            for (int workerId = 1; workerId < countProcess; ++workerId) {
+                int sendSolution = 0;
+                if (solutionBoards.empty() && successWorkerId == -1 &&
+                    countSolutionsReportedByWorkers[workerId - 1] > 0) {
+                    sendSolution = 1;
+                    successWorkerId = workerId;
+                }
+                MPI_Send(&sendSolution, 1, MPI_INT, workerId, CUSTOM_MPI_STOP_WORK_TAG, MPI_COMM_WORLD);
+            }
+        }
+
+        if (DEBUG >= DEBUG_BASE) {
+            std::cout << "[" << processId << "]: all problem boards have been computed!" << std::endl;
+        }
+    } else {
+        unsigned int processLoad = 0;
+        // solutions counted by the worker in count mode
+        long long countedSolutions = 0;
+        // the solutions of the batches are moved in the context of the worker
+        bool stopped = false;
+        SolverContext context(stopped);
+        // the master stops the searches of the workers once the run is solved
+        pollStopWork = !countMode;
+        // workers wait for work to do while the working queue is not empty
+        MPI_Request workerRequestIdle;
+        MPI_Status idleRequestStatus;
+        do {
+            // notice master process is idle
+            // send to master the number of solutions founds
+            long long countSolutions = countMode ? countedSolutions : (long long) solutionBoards.size();
+            MPI_Isend(&countSolutions, 1, MPI_LONG_LONG, 0, CUSTOM_MPI_IDLE_TAG, MPI_COMM_WORLD, &workerRequestIdle);
+            MPI_Wait(&workerRequestIdle, &idleRequestStatus);
+
+            // wait work from master
+            int countReceivedBoards = receivePushBackDeque(problemBoards, 0, CUSTOM_MPI_POSSIBILITIES_TAG,
                                                            MPI_COMM_WORLD);
             processLoad += countReceivedBoards;
 
-            if (countReceivedBoards > 0) {
-                SudokuBoard solution = solveProblemsOnNode(problemBoards);
-                if (!solution.isEmpty()) {
-                    solutionBoards.emplace_back(solution);
+            if (countReceivedBoards > 0 && countMode) {
+                // count solutions of the boards, up to the remaining limit
+                SolutionCounter counter(COUNT_SOLUTIONS_LIMIT > 0 ? std::max(1LL, COUNT_SOLUTIONS_LIMIT - countedSolutions)
+                                                                  : COUNT_SOLUTIONS_LIMIT);
+                const int status = solveProblemsOnNode(problemBoards, &counter, context);
+                if (DETERMINISTIC) {
+                    MPI_Send(&orderedSearchNodes, 1, MPI_LONG_LONG, 0, CUSTOM_MPI_REPORT_TAG, MPI_COMM_WORLD);
+                }
+                countedSolutions += counter.total();
+                if (status == SOLVER_SOLVED && solutionBoards.empty()) {
+                    solutionBoards.emplace_back(std::move(context.solution));
+                }
+            } else if (countReceivedBoards > 0) {
+                const int status = solveProblemsOnNode(problemBoards, nullptr, context);
+                if (DETERMINISTIC) {
+                    MPI_Send(&orderedSearchNodes, 1, MPI_LONG_LONG, 0, CUSTOM_MPI_REPORT_TAG, MPI_COMM_WORLD);
+                }
+                if (status == SOLVER_SOLVED) {
+                    solutionBoards.emplace_back(std::move(context.solution));
                     firstWinnerWorker = processId;
                     if (DEBUG >= DEBUG_BASE) {
                         std::cout << "[" << processId << "]: a solution has been found :" << std::endl
-                                  << solution << std::endl;
+                                  << solutionBoards.back() << std::endl;
                     }
                     // mark current process as winner and inform master process, then finish
                     successWorkerId = processId;
                     countSolutions = solutionBoards.size();
-                    MPI_Isend(&countSolutions, 1, MPI_INT, 0, CUSTOM_MPI_IDLE_TAG, MPI_COMM_WORLD, &workerRequestIdle);
+                    MPI_Isend(&countSolutions, 1, MPI_LONG_LONG, 0, CUSTOM_MPI_IDLE_TAG, MPI_COMM_WORLD, &workerRequestIdle);
                     break;
                 }
             } else {
@@ -208,24 +890,136 @@ void initSolveMPI() {
             }
         } while (true);
 
+        flushTraceFiles();
+
+        if (!countMode && isBudgetSet() && successWorkerId != processId) {
+            // stopped by the master without solution, report the best partial board
+            long long report[2] = {checkBudget(), searchNodes};
+            MPI_Send(report, 2, MPI_LONG_LONG, 0, CUSTOM_MPI_PARTIAL_TAG, MPI_COMM_WORLD);
+            sendSudokuBoard(bestPartialBoard, 0, CUSTOM_MPI_PARTIAL_TAG, MPI_COMM_WORLD);
+        }
+
+        if (countMode) {
+            // the master may ask for one of the solutions
+            int sendSolution;
+            MPI_Recv(&sendSolution, 1, MPI_INT, 0, CUSTOM_MPI_STOP_WORK_TAG, MPI_COMM_WORLD, &idleRequestStatus);
+            if (sendSolution) {
+                successWorkerId = processId;
+                firstWinnerWorker = processId;
+            }
+        }
+
        /* std::cout << "[" << processId << "]: finished to work. " << solutionBoards.size()
                   << " solutions found over "
                   << processLoad << " problem boards assigned." << std::endl; */
     }
 
+    if (DEBUG >= DEBUG_BASE) {
+        std::cout << "[" << processId << "]: explored " << searchNodes << " search nodes, split the search "
+                  << searchSplits << " times, restarted the portfolio " << portfolioRestarts << " times."
+                  << std::endl;
+        long long kernelNodes = 0;
+        for (auto const &kernel: bitmaskKernels) {
+            kernelNodes += kernel.getNodes();
+        }
+        std::cout << "[" << processId << "]: handed off " << kernelHandoffs << " boards with less than "
+                  << KERNEL_THRESHOLD << "% of empty cells to the bitmask kernel, " << kernelSolutions
+                  << " solved over " << kernelNodes << " kernel nodes." << std::endl;
+        std::cout << "[" << processId << "]: ran " << discrepancyIterations
+                  << " iterations of limited discrepancy search." << std::endl;
+        std::cout << "[" << processId << "]: saved " << deadStateRecords << " boards without solution, pruned "
+                  << deadStateHits << " of them." << std::endl;
+        std::cout << "[" << processId << "]: locked candidates applied " << lockedCandidatesCalls
+                  << " times, removed " << lockedCandidatesPointingHits << " candidates by pointing and "
+                  << lockedCandidatesClaimingHits << " by claiming." << std::endl;
+        std::cout << "[" << processId << "]: all-different strategy applied " << allDifferentCalls
+                  << " times, removed " << allDifferentHits << " candidates." << std::endl;
+        printStrategySchedulers(processId);
+    }
+
+    // budgets exhausted on the processes, every process reaches this point in count mode
+    if (budgetOnRun == BUDGET_NONE) {
+        budgetOnRun = checkBudget();
+    }
+    nodesOnRun += searchNodes;
+    if (countMode && isBudgetSet()) {
+        int budget = budgetOnRun;
+        long long nodes = searchNodes;
+        MPI_Reduce(&budget, &budgetOnRun, 1, MPI_INT, MPI_MAX, 0, MPI_COMM_WORLD);
+        MPI_Reduce(&nodes, &nodesOnRun, 1, MPI_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+    }
+    if (STATS_OUTPUT != STATS_OFF) {
+        // every process reaches this point when the statistics are enabled
+        reportStatistics(processId);
+    }
+
     // collect results
+    if (processId == 0 && countMode) {
+        long long countSolutions = masterCounter.total();
+        for (long long reportedCount: countSolutionsReportedByWorkers) {
+            countSolutions += reportedCount;
+        }
+        const bool limitReached = COUNT_SOLUTIONS_LIMIT > 0 && countSolutions >= COUNT_SOLUTIONS_LIMIT;
+        if (limitReached) {
+            // workers stop at the limit on their own, the sum of their counts may exceed it
+            countSolutions = COUNT_SOLUTIONS_LIMIT;
+        }
+        std::string countEnd = " (whole search tree explored).";
+        if (limitReached) {
+            countEnd = " (limit reached).";
+        } else if (budgetOnRun != BUDGET_NONE) {
+            countEnd = " (budget exhausted, search tree partially explored).";
+        }
+        std::cout << "[" << processId << "]: Counted " << countSolutions << " solutions" << countEnd << std::endl;
+        if (countSolutions == 1 && !limitReached && budgetOnRun == BUDGET_NONE) {
+            std::cout << "[" << processId << "]: The board has a unique solution." << std::endl;
+        } else if (countSolutions > 1) {
+            std::cout << "[" << processId << "]: The board has several solutions." << std::endl;
+        }
+    }
     if (processId == 0) {
         if (successWorkerId != -1) {
-            receivePushBackDeque(solutionBoards, successWorkerId, CUSTOM_MPI_SOLUTIONS_TAG,
+            if (successWorkerId != processId) {
+                receivePushBackDeque(solutionBoards, successWorkerId, CUSTOM_MPI_SOLUTIONS_TAG,
                                  MPI_COMM_WORLD);
+            }
             std::cout << "[" << processId << "]: Worker[" << successWorkerId << "] found a solution." << std::endl;
             std::cout << "[" << processId << "] Solution for board:" << std::endl << solutionBoards.front()
                       << std::endl;
+        } else if (countMode && !solutionBoards.empty()) {
+            // the master counted a solution itself, during the generation or without workers
+            std::cout << "[" << processId << "]: The master found a solution." << std::endl;
+            std::cout << "[" << processId << "] Solution for board:" << std::endl << solutionBoards.front()
+                      << std::endl;
         } else {
             std::cout << "[" << processId << "] No solution from workers for the board." << std::endl;
         }
+        if (DETERMINISTIC) {
+            // the nodes of the boards after the winning one depend on when they have been stopped
+            long long orderedNodes = orderedSearchNodes;
+            for (int board = 0; board < (int) orderedNodesOfBoard.size(); ++board) {
+                if (winningBoard == -1 || board <= winningBoard) {
+                    orderedNodes += orderedNodesOfBoard[board];
+                }
+            }
+            std::cout << "[" << processId << "]: Deterministic search, " << orderedNodes << " search nodes";
+            if (winningBoard != -1) {
+                std::cout << " up to the winning problem board " << winningBoard;
+            }
+            std::cout << "." << std::endl;
+        }
+        if (budgetOnRun != BUDGET_NONE) {
+            std::cout << "[" << processId << "]: The " << getBudgetName(budgetOnRun) << " budget has been exhausted, "
+                      << nodesOnRun << " search nodes explored, peak memory of the master "
+                      << getPeakResidentMemory() / 1024 << " MiB." << std::endl;
+        }
+        if (budgetOnRun != BUDGET_NONE && solutionBoards.empty() && !bestPartialBoard.isEmpty()) {
+            std::cout << "[" << processId << "]: Best partial board, " << bestPartialSolvedCells << "/"
+                      << bestPartialBoard.getSize() << " cells solved :" << std::endl << bestPartialBoard
+                      << std::endl;
+        }
     }
-    if (successWorkerId == processId) {
+    if (successWorkerId == processId && processId != 0) {
         // send results to master
         if (processId == firstWinnerWorker) {
             sendAndConsumeDeque(solutionBoards, 0, CUSTOM_MPI_SOLUTIONS_TAG, MPI_COMM_WORLD);
@@ -243,30 +1037,196 @@ void initSolveMPI() {
     }
 
     // assert sudoku returned is valid
+    BoardConflict conflict;
     if (processId == 0) {
-        if (!solutionBoards.front().checkIsValidConfig()) {
-            std::cerr << "ERROR : Return sudoku is invalid !" << std::endl;
+        flushTraceFiles();
+        if (solutionBoards.empty()) {
+            // nothing to check
+            MPI_Abort(MPI_COMM_WORLD, budgetOnRun != BUDGET_NONE ? CUSTOM_MPI_BUDGET_EXHAUSTED_RETURNED : 0);
+        } else if (solutionBoards.front().findFirstConflict(conflict)) {
+            std::cerr << "ERROR : Return sudoku is invalid, " << conflict << " !" << std::endl;
             MPI_Abort(MPI_COMM_WORLD, CUSTOM_MPI_INVALID_SUDOKU_RETURNED);
         } else {
-            // everything is fine
+            // everything is fine, the count may have been cut by the budget
             // end of the work for everyone !
-            MPI_Abort(MPI_COMM_WORLD, 0);
+            MPI_Abort(MPI_COMM_WORLD,
+                      countMode && budgetOnRun != BUDGET_NONE ? CUSTOM_MPI_BUDGET_EXHAUSTED_RETURNED : 0);
         }
     }
 }
 
 // Begin of Solver methods
-SudokuBoard solveBoard(SudokuBoard &board, bool &solutionFound, int row, int col) {
-    if (solutionFound) {
-        return SudokuBoard(0);
+SolverContext::SolverContext(bool &stop) : stop(stop), solution(0), status(SOLVER_OPEN), nodes(0), deadEnds(0) {}
+
+int solveBoard(SudokuBoard &board, SolverContext &context) {
+    SearchStack search(board);
+    return search.run(context, -1);
+}
+
+bool isBudgetSet() {
+    return TIME_BUDGET > 0 || NODE_BUDGET > 0 || MEMORY_BUDGET > 0;
+}
+
+void startBudget() {
+    budgetStart = omp_get_wtime();
+}
+
+int checkBudget() {
+    int exhausted;
+#pragma omp atomic read
+    exhausted = exhaustedBudget;
+    if (exhausted != BUDGET_NONE || !isBudgetSet()) {
+        return exhausted;
+    }
+
+    long long nodes;
+#pragma omp atomic read
+    nodes = searchNodes;
+    if (TIME_BUDGET > 0 && omp_get_wtime() - budgetStart >= TIME_BUDGET) {
+        exhausted = BUDGET_TIME;
+    } else if (NODE_BUDGET > 0 && nodes >= NODE_BUDGET) {
+        exhausted = BUDGET_NODES;
+    } else if (MEMORY_BUDGET > 0 && getPeakResidentMemory() >= MEMORY_BUDGET * 1024) {
+        exhausted = BUDGET_MEMORY;
+    }
+    if (exhausted != BUDGET_NONE) {
+#pragma omp critical
+        {
+            // the first budget exhausted is kept
+            if (exhaustedBudget == BUDGET_NONE) {
+                exhaustedBudget = exhausted;
+            }
+            exhausted = exhaustedBudget;
+        }
+    }
+    return exhausted;
+}
+
+std::string getStatusName(int status) {
+    switch (status) {
+        case SOLVER_SOLVED:
+            return "solved";
+        case SOLVER_DEAD_END:
+            return "dead end";
+        case SOLVER_CANCELLED:
+            return "cancelled";
+        case SOLVER_TIMEOUT:
+            return "timeout";
+        case SOLVER_OPEN:
+            return "branched";
+        default:
+            return "root";
+    }
+}
+
+std::string getBudgetName(int budget) {
+    switch (budget) {
+        case BUDGET_TIME:
+            return "time";
+        case BUDGET_NODES:
+            return "node";
+        case BUDGET_MEMORY:
+            return "memory";
+        default:
+            return "none";
     }
+}
+
+bool checkStopWork() {
+    bool received;
+#pragma omp atomic read
+    received = stopWorkReceived;
+    if (received || !pollStopWork) {
+        return received;
+    }
+    // only the main thread exchanges messages
+    int isMainThread = 0;
+    MPI_Is_thread_main(&isMainThread);
+    if (!isMainThread) {
+        return false;
+    }
+    int stopMessage = 0;
+    MPI_Status stopStatus;
+    MPI_Iprobe(0, CUSTOM_MPI_STOP_WORK_TAG, MPI_COMM_WORLD, &stopMessage, &stopStatus);
+    if (!stopMessage) {
+        return false;
+    }
+    int stop;
+    MPI_Recv(&stop, 1, MPI_INT, 0, CUSTOM_MPI_STOP_WORK_TAG, MPI_COMM_WORLD, &stopStatus);
+#pragma omp atomic write
+    stopWorkReceived = true;
+    return true;
+}
 
-    // check end reached => terminate recursion
-    if (board.isSolved()) {
-        // the board is solved, return it
-        return board;
+void finishSearchesPollingStopWork(int &finishedThreads) {
+#pragma omp atomic
+    finishedThreads += 1;
+    if (!pollStopWork || omp_get_thread_num() != 0) {
+        return;
     }
+    // the main thread is the only one to receive the stop requests, it polls them until the others are done
+    int finished;
+#pragma omp atomic read
+    finished = finishedThreads;
+    while (finished < omp_get_num_threads() && !checkStopWork()) {
+        std::this_thread::sleep_for(std::chrono::microseconds(STOP_WORK_POLL_MICROSECONDS));
+#pragma omp atomic read
+        finished = finishedThreads;
+    }
+}
 
+void pollStopWorkTask(int const &queuedTasks, int const &unfinishedTasks) {
+    // only the main thread receives the stop requests, the task goes on until one runs it
+    if (checkStopWork()) {
+        return;
+    }
+    int unfinished;
+#pragma omp atomic read
+    unfinished = unfinishedTasks;
+    if (unfinished == 0) {
+        return;
+    }
+    int waitingTasks;
+#pragma omp atomic read
+    waitingTasks = queuedTasks;
+    if (waitingTasks == 0) {
+        // nothing else to run on this thread
+        std::this_thread::sleep_for(std::chrono::microseconds(STOP_WORK_POLL_MICROSECONDS));
+    }
+    int const *sharedQueuedTasks = &queuedTasks;
+    int const *sharedUnfinishedTasks = &unfinishedTasks;
+#pragma omp task firstprivate(sharedQueuedTasks, sharedUnfinishedTasks)
+    pollStopWorkTask(*sharedQueuedTasks, *sharedUnfinishedTasks);
+}
+
+long long getPeakResidentMemory() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    // KiB on Linux
+    return usage.ru_maxrss;
+}
+
+void recordPartialBoard(SudokuBoard const &board) {
+    if (!isBudgetSet()) {
+        return;
+    }
+    int bestSolvedCells;
+#pragma omp atomic read
+    bestSolvedCells = bestPartialSolvedCells;
+    if (board.getCountSolvedCells() <= bestSolvedCells) {
+        return;
+    }
+#pragma omp critical
+    {
+        if (board.getCountSolvedCells() > bestPartialSolvedCells) {
+            bestPartialBoard = board;
+#pragma omp atomic write
+            bestPartialSolvedCells = board.getCountSolvedCells();
+        }
+    }
+}
+
+int propagateBoard(SudokuBoard &board, bool const &solutionFound) {
     /*
      * This is a chunk strategy for big boards, it helps dealing with massive crook operations
      * and reduce the amount of cpu used.
@@ -279,151 +1239,1071 @@ SudokuBoard solveBoard(SudokuBoard &board, bool &solutionFound, int row, int col
             std::cout << "count before solve = " << beforeSolve << ", b: " << beforeCrook << "% - a: " << afterCrook << "%" << std::endl;
         }
     } */
-    // std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
-    solveReduceCrook(board, solutionFound);
-    // std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
-    // std::cout << "Time elapsed = " << std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count() << "[ms]" << std::endl;
+    int status = solveReduceCrook(board, solutionFound);
+
+    // humanistic strategies are stalled, apply global all-different filtering on large boards
+    while (status == SOLVER_OPEN && isAllDifferentStrategyEnabled(board)) {
+        const int solvedCellsBefore = board.getCountSolvedCells();
+        const std::chrono::steady_clock::time_point begin = STATS_OUTPUT != STATS_OFF
+                                                            ? std::chrono::steady_clock::now()
+                                                            : std::chrono::steady_clock::time_point();
+        const int changedAllDifferent = allDifferentStrategy(board);
+        if (STATS_OUTPUT != STATS_OFF) {
+            SearchStatistics &statistics = searchStatistics.at(omp_get_thread_num());
+            statistics.allDifferentCalls += 1;
+            statistics.allDifferentNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - begin).count();
+            if (changedAllDifferent > 0) {
+                statistics.allDifferentEliminations += changedAllDifferent;
+                statistics.allDifferentPlacements += board.getCountSolvedCells() - solvedCellsBefore;
+            }
+        }
+        if (changedAllDifferent == -1) {
+            board = SudokuBoard(0);
+            return SOLVER_DEAD_END;
+        }
+        if (changedAllDifferent == 0) {
+            break;
+        }
+        status = solveReduceCrook(board, solutionFound);
+    }
+    return status;
+}
 
-    if (board.isEmpty()) {
+SearchFrame::SearchFrame(SudokuBoard &&board, std::vector<CellAssignment> &&alternatives, std::uint64_t entryHash,
+                         int discrepancies) : board(std::move(board)), alternatives(std::move(alternatives)), next(0),
+                                              entryHash(entryHash), discrepancies(discrepancies), complete(true) {}
+
+SearchStack::SearchStack(SudokuBoard const &board) : root(board), hasRoot(true) {}
+
+int SearchStack::run(SolverContext &context, long long maxNodes) {
+    bool &solutionFound = context.stop;
+    long long exploredNodes = 0;
+    long long flushedNodes = 0;
+    long long deadEnds = 0;
+    // the counts are flushed when the budgets are checked and at the end of the run, not by node
+    auto flushCounts = [&]() {
+#pragma omp atomic
+        searchNodes += exploredNodes - flushedNodes;
+        context.nodes += exploredNodes - flushedNodes;
+        context.deadEnds += deadEnds;
+        flushedNodes = exploredNodes;
+        deadEnds = 0;
+        if (traceSearch >= 0) {
+            flushTraceFile();
+        }
+    };
+    auto isStoppedByBudget = [&]() {
+        flushCounts();
+        if (checkBudget() == BUDGET_NONE) {
+            return false;
+        }
+        // stop the searches sharing the flag, they report no solution
+#pragma omp critical
+        solutionFound = true;
+        context.status = SOLVER_TIMEOUT;
+        return true;
+    };
+    auto isStoppedByMaster = [&]() {
+        if (!checkStopWork()) {
+            return false;
+        }
+        // the searches sharing the flag are cancelled too
+#pragma omp critical
+        solutionFound = true;
+        flushCounts();
+        context.status = SOLVER_CANCELLED;
+        return true;
+    };
+    SearchStatistics *statistics = STATS_OUTPUT != STATS_OFF ? &searchStatistics.at(omp_get_thread_num()) : nullptr;
+    while (!solutionFound && (maxNodes < 0 || exploredNodes < maxNodes)) {
+        if (isBudgetSet() && this->exploredNodes % BUDGET_CHECK_PERIOD == 0 && isStoppedByBudget()) {
+            return context.status;
+        }
+        if (pollStopWork && this->exploredNodes % BUDGET_CHECK_PERIOD == 0 && isStoppedByMaster()) {
+            return context.status;
+        }
+        SudokuBoard node(0);
+        int discrepancies = discrepancyLimit;
+        TraceRecord record = {-1, 0, (std::int32_t) frames.size(), 0, SOLVER_OPEN, 0, traceSearch};
+        if (hasRoot) {
+            node = std::move(root);
+            root = SudokuBoard(0);
+            hasRoot = false;
+            if (isTracing()) {
+                traceSearch = traceSearchRoot(node);
+                record.search = traceSearch;
+            }
+        } else {
+            if (frames.empty()) {
+                // all alternatives have been explored
+                flushCounts();
+                context.status = SOLVER_DEAD_END;
+                return context.status;
+            }
+            SearchFrame &frame = frames.back();
+            if (frame.next < frame.alternatives.size() && discrepancyLimit >= 0 && frame.next > 0 &&
+                frame.discrepancies == 0) {
+                // no discrepancy left to try the other alternatives
+                frame.complete = false;
+                discrepancyCut = true;
+                frame.next = frame.alternatives.size();
+            }
+            if (frame.next == frame.alternatives.size()) {
+                // no alternative left, the node is dead if all its alternatives have been explored here
+                const bool complete = frame.complete;
+                if (complete) {
+                    recordDeadState(frame.entryHash);
+                    recordDeadState(frame.board.getZobristHash());
+                }
+                // backtrack
+                frames.pop_back();
+                if (statistics) {
+                    statistics->backtracks += 1;
+                }
+                if (complete) {
+                    recordFailure(solutionFound);
+                } else if (!frames.empty()) {
+                    frames.back().complete = false;
+                }
+                continue;
+            }
+
+            // set the value of the next alternative, any alternative but the first one is a discrepancy
+            discrepancies = frame.discrepancies - (frame.next > 0 ? 1 : 0);
+            CellAssignment const &alternative = frame.alternatives[frame.next++];
+            node = frame.board;
+            node.setValueAndUpdatePossibilities(alternative.row, alternative.col, alternative.value);
+            record.cell = alternative.row * node.getRowSize() + alternative.col;
+            record.value = alternative.value;
+        }
+
+        ++exploredNodes;
+        ++this->exploredNodes;
+        if (statistics) {
+            statistics->nodes += 1;
+            statistics->maxDepth = std::max(statistics->maxDepth, (long long) frames.size());
+        }
+        const int status = expand(node, solutionFound, discrepancies, record);
+        if (traceSearch >= 0) {
+            record.outcome = status;
+            traceSearchNode(record);
+        }
+        if (status == SOLVER_SOLVED) {
+            // solution found ! the nodes above it are not dead if the search goes on
+            for (auto &frame: frames) {
+                frame.complete = false;
+            }
+            flushCounts();
+            context.solution = std::move(node);
+            context.status = SOLVER_SOLVED;
+            return context.status;
+        }
+        if (status == SOLVER_DEAD_END) {
+            ++deadEnds;
+            if (statistics) {
+                statistics->deadEnds += 1;
+            }
+        }
+        if (status == SOLVER_CANCELLED && (isStoppedByBudget() || isStoppedByMaster())) {
+            return context.status;
+        }
+    }
+
+    flushCounts();
+    context.status = solutionFound ? SOLVER_CANCELLED : isExhausted() ? SOLVER_DEAD_END : SOLVER_TIMEOUT;
+    return context.status;
+}
+
+int SearchStack::expand(SudokuBoard &node, bool &solutionFound, int discrepancies, TraceRecord &record) {
+    // check end reached
+    if (node.isSolved()) {
+        return SOLVER_SOLVED;
+    }
+
+    // the board may have been proven dead by another branch, restart or thread
+    const std::uint64_t entryHash = node.getZobristHash();
+    if (isKnownDeadState(entryHash)) {
+        recordFailure(solutionFound);
+        return SOLVER_DEAD_END;
+    }
+
+    // near the leaves, brute force is cheaper than the strategies
+    if (isKernelHandoff(node, false)) {
+        return handOffToKernel(node, solutionFound, entryHash, record);
+    }
+
+    const int countSolvedCellsBefore = node.getCountSolvedCells();
+    const int status = propagateBoard(node, solutionFound);
+    if (status == SOLVER_CANCELLED && !solutionFound) {
+        // stopped by the budget, the node is not dead
+        return SOLVER_CANCELLED;
+    }
+    if (status == SOLVER_DEAD_END || status == SOLVER_CANCELLED) {
         // crook discovered a dead end
-        return board;
+        if (!solutionFound) {
+            recordDeadState(entryHash);
+        }
+        recordFailure(solutionFound);
+        return SOLVER_DEAD_END;
+    }
+    record.propagated = node.getCountSolvedCells() - countSolvedCellsBefore;
+    if (status == SOLVER_SOLVED) {
+        return SOLVER_SOLVED;
+    }
+    recordPartialBoard(node);
+    if (node.getZobristHash() != entryHash && isKnownDeadState(node.getZobristHash())) {
+        recordDeadState(entryHash);
+        recordFailure(solutionFound);
+        return SOLVER_DEAD_END;
+    }
+    if (isKernelHandoff(node, node.getCountSolvedCells() == countSolvedCellsBefore)) {
+        return handOffToKernel(node, solutionFound, entryHash, record);
     }
 
-    std::pair<int, int> nextCell = board.nextEmptyCellComputed();
-    // solution found !
-    if (nextCell.first == -1) {
-        return board;
+    // try all alternatives of the branching : values of a cell or cells of a value in a unit
+    std::vector<CellAssignment> alternatives = computeBranchAlternatives(node);
+    if (alternatives.empty()) {
+        if (!solutionFound) {
+            recordDeadState(entryHash);
+        }
+        recordFailure(solutionFound);
+        return SOLVER_DEAD_END;
     }
+    frames.emplace_back(std::move(node), std::move(alternatives), entryHash, discrepancies);
+    return SOLVER_OPEN;
+}
 
-    if (board[row][col] != 0) {
-        // jump to next cell
-        // current cell solved, continue recursion
-        return solveBoard(board, solutionFound, nextCell.first, nextCell.second);
+int SearchStack::handOffToKernel(SudokuBoard &node, bool &solutionFound, std::uint64_t entryHash,
+                                 TraceRecord &record) {
+#pragma omp atomic
+    kernelHandoffs += 1;
+    BitmaskKernel &kernel = bitmaskKernels.at(omp_get_thread_num());
+    const long long kernelNodesBefore = kernel.getNodes();
+    const bool solved = kernel.solve(node, solutionFound);
+    record.kernelNodes = (std::int32_t) std::min(kernel.getNodes() - kernelNodesBefore, (long long) INT32_MAX);
+    if (solved) {
+#pragma omp atomic
+        kernelSolutions += 1;
+        return SOLVER_SOLVED;
+    }
+    if (!solutionFound && (checkBudget() != BUDGET_NONE || checkStopWork())) {
+        // stopped by the budget or by the master, the node is not dead
+        return SOLVER_CANCELLED;
+    }
+    if (!solutionFound) {
+        recordDeadState(entryHash);
     }
+    recordFailure(solutionFound);
+    return SOLVER_DEAD_END;
+}
 
+void SearchStack::recordFailure(bool const &solutionFound) {
+    if (solutionFound || frames.empty()) {
+        return;
+    }
+    SearchFrame const &parent = frames.back();
+    recordFailedAlternative(parent.board, parent.alternatives[parent.next - 1]);
+}
 
-    int nextRow = nextCell.first;
-    int nextCol = nextCell.second;
+int SearchStack::split(std::deque<SudokuBoard> &boards) {
+    for (auto &frame: frames) {
+        // alternatives given away from this node or a deeper one won't be explored here
+        frame.complete = false;
+        if (frame.next < frame.alternatives.size()) {
+            const int countAlternatives = frame.alternatives.size() - frame.next;
+            for (std::size_t i = frame.next; i < frame.alternatives.size(); ++i) {
+                CellAssignment const &alternative = frame.alternatives[i];
+                SudokuBoard copyBoard = frame.board;
+                copyBoard.setValueAndUpdatePossibilities(alternative.row, alternative.col, alternative.value);
+                boards.emplace_back(std::move(copyBoard));
+            }
+            frame.alternatives.resize(frame.next);
+            return countAlternatives;
+        }
+    }
+    return 0;
+}
+
+bool SearchStack::isExhausted() const {
+    return !hasRoot && frames.empty();
+}
+
+std::size_t SearchStack::getDepth() const {
+    return frames.size();
+}
+
+long long SearchStack::getExploredNodes() const {
+    return exploredNodes;
+}
 
-    // cell not solved, try all possible numbers in the cell
-    // value is valid, continue in to deep search
-    for (int possibleValue :board.getPossiblesValuesInCells()[row][col]) {
-        SudokuBoard copyBoard = board;
+bool isKernelHandoff(SudokuBoard const &board, bool stalled) {
+    // the kernel stops at the first solution
+    if (KERNEL_THRESHOLD <= 0 || COUNT_SOLUTIONS_LIMIT != 0 || board.getBlockSize() >= SUDOKU_MASK_SIZE) {
+        return false;
+    }
+    const int countEmptyCells = board.getSize() - board.getCountSolvedCells();
+    return countEmptyCells * 100 <= board.getSize() * (stalled ? 2 * KERNEL_THRESHOLD : KERNEL_THRESHOLD);
+}
 
-        // set the value
-        copyBoard.setValueAndUpdatePossibilities(row, col, possibleValue);
+bool BitmaskKernel::solve(SudokuBoard &board, bool const &solutionFound) {
+    n = board.getSudokuDimension();
+    size = board.getBlockSize();
+    // buffers keep their capacity between calls
+    grid.assign(size * size, 0);
+    rowsUsed.assign(size, SudokuMask());
+    columnsUsed.assign(size, SudokuMask());
+    blocksUsed.assign(size, SudokuMask());
+    candidates.resize(size * size);
+    emptyCells.clear();
+
+    for (int row = 0; row < size; ++row) {
+        for (int col = 0; col < size; ++col) {
+            const int cell = row * size + col;
+            const int value = board.get(row, col);
+            if (value != 0) {
+                grid[cell] = value;
+                rowsUsed[row].set(value);
+                columnsUsed[col].set(value);
+                blocksUsed[board.getBlockOfCell(row, col)].set(value);
+            } else {
+                candidates[cell].reset();
+                for (int possibleValue: board.getPossiblesValuesInCells()[row][col]) {
+                    candidates[cell].set(possibleValue);
+                }
+                emptyCells.push_back(cell);
+            }
+        }
+    }
+
+    cancelled = false;
+    if (!search(0, solutionFound)) {
+        return false;
+    }
+    for (int cell: emptyCells) {
+        board.setValueAndUpdatePossibilities(cell / size, cell % size, grid[cell]);
+    }
+    return true;
+}
+
+bool BitmaskKernel::search(std::size_t depth, bool const &solutionFound) {
+    if (depth == emptyCells.size()) {
+        return true;
+    }
+    if (solutionFound || cancelled) {
+        return false;
+    }
+    if (nodes % KERNEL_BUDGET_CHECK_PERIOD == 0 && (checkBudget() != BUDGET_NONE || checkStopWork())) {
+        // the whole search unwinds, not only the current node
+        cancelled = true;
+        return false;
+    }
+    ++nodes;
+
+    // cell with less candidates
+    std::size_t bestIndex = depth;
+    std::size_t bestCount = size + 1;
+    SudokuMask bestCandidates;
+    for (std::size_t i = depth; i < emptyCells.size(); ++i) {
+        const int cell = emptyCells[i];
+        const int row = cell / size;
+        const int col = cell % size;
+        const SudokuMask cellCandidates =
+                candidates[cell] & ~(rowsUsed[row] | columnsUsed[col] | blocksUsed[(row / n) * n + col / n]);
+        const std::size_t count = cellCandidates.count();
+        if (count < bestCount) {
+            bestIndex = i;
+            bestCount = count;
+            bestCandidates = cellCandidates;
+            if (count <= 1) {
+                break;
+            }
+        }
+    }
+    if (bestCount == 0) {
+        return false;
+    }
+
+    std::swap(emptyCells[depth], emptyCells[bestIndex]);
+    const int cell = emptyCells[depth];
+    const int row = cell / size;
+    const int col = cell % size;
+    const int block = (row / n) * n + col / n;
+    for (int value = 1; value <= size; ++value) {
+        if (!bestCandidates[value]) {
+            continue;
+        }
+        grid[cell] = value;
+        rowsUsed[row].set(value);
+        columnsUsed[col].set(value);
+        blocksUsed[block].set(value);
+        if (search(depth + 1, solutionFound)) {
+            return true;
+        }
+        rowsUsed[row].reset(value);
+        columnsUsed[col].reset(value);
+        blocksUsed[block].reset(value);
+    }
+    grid[cell] = 0;
+    return false;
+}
+
+long long BitmaskKernel::getNodes() const {
+    return nodes;
+}
 
-        SudokuBoard solution = solveBoard(copyBoard, solutionFound, nextRow, nextCol);
-        // if solution has been found, return recursion
+void SearchStack::setDiscrepancyLimit(int limit) {
+    discrepancyLimit = limit;
+}
+
+bool SearchStack::isDiscrepancyCut() const {
+    return discrepancyCut;
+}
+
+int solveWithDiscrepancies(SudokuBoard const &board, int limit, SolverContext &context, bool &exhausted) {
+    SearchStack search(board);
+    search.setDiscrepancyLimit(limit);
+    const int status = search.run(context, -1);
+    exhausted = status == SOLVER_DEAD_END && !search.isDiscrepancyCut();
+#pragma omp atomic
+    discrepancyIterations += 1;
+    return status;
+}
+
+int solveLimitedDiscrepancy(SudokuBoard const &board, SolverContext &context) {
+    for (int limit = 0; !context.stop; ++limit) {
+        bool exhausted;
+        const int status = solveWithDiscrepancies(board, limit, context, exhausted);
+        if (status == SOLVER_SOLVED || exhausted) {
+            return status;
+        }
+    }
+    if (context.status != SOLVER_TIMEOUT) {
+        context.status = SOLVER_CANCELLED;
+    }
+    return context.status;
+}
+
+DeadStateTable::DeadStateTable(int bits) : hashes(std::size_t(1) << bits, 0) {}
+
+bool DeadStateTable::contains(std::uint64_t hash) const {
+    return hash != 0 && hashes[hash & (hashes.size() - 1)] == hash;
+}
+
+void DeadStateTable::insert(std::uint64_t hash) {
+    hashes[hash & (hashes.size() - 1)] = hash;
+}
+
+std::uint64_t zobristKey(int cell, int value) {
+    // splitmix64 of the (cell, value) pair
+    std::uint64_t key = (std::uint64_t) cell * (SUDOKU_MASK_SIZE + 1) + value + 0x9E3779B97F4A7C15ULL;
+    key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    key = (key ^ (key >> 27)) * 0x94D049BB133111EBULL;
+    return key ^ (key >> 31);
+}
+
+bool isKnownDeadState(std::uint64_t hash) {
+    if (TRANSPOSITION_POLICY == TRANSPOSITION_OFF || hash == 0) {
+        return false;
+    }
+    DeadStateTable &table = deadStateTables.at(omp_get_thread_num());
+    bool known = table.contains(hash);
+    if (!known && TRANSPOSITION_POLICY == TRANSPOSITION_SHARED) {
+        const std::size_t sharedMask = (std::size_t(1) << SHARED_TRANSPOSITION_TABLE_BITS) - 1;
+        known = sharedDeadStates[hash & sharedMask].load(std::memory_order_relaxed) == hash;
+        if (known) {
+            table.insert(hash);
+        }
+    }
+    if (known) {
+#pragma omp atomic
+        deadStateHits += 1;
+    }
+    return known;
+}
+
+void recordDeadState(std::uint64_t hash) {
+    if (TRANSPOSITION_POLICY == TRANSPOSITION_OFF || hash == 0) {
+        return;
+    }
+    deadStateTables.at(omp_get_thread_num()).insert(hash);
+    if (TRANSPOSITION_POLICY == TRANSPOSITION_SHARED) {
+        const std::size_t sharedMask = (std::size_t(1) << SHARED_TRANSPOSITION_TABLE_BITS) - 1;
+        sharedDeadStates[hash & sharedMask].store(hash, std::memory_order_relaxed);
+    }
+#pragma omp atomic
+    deadStateRecords += 1;
+}
+
+SearchVariant &getSearchVariant() {
+    return searchVariants.at(omp_get_thread_num());
+}
+
+std::pair<int, int> nextEmptyCellRandomized(SudokuBoard const &board, std::mt19937_64 &random) {
+    std::pair<int, int> lessPossibilitiesCell(-1, -1);
+    std::size_t lessPossibilities = 0;
+    int countTies = 0;
+    for (int row = 0; row < board.getColumnSize(); row++) {
+        for (int col = 0; col < board.getRowSize(); col++) {
+            if (board.get(row, col) != 0) {
+                continue;
+            }
+            const std::size_t possibilities = board.getPossiblesValuesInCells()[row][col].size();
+            if (lessPossibilitiesCell.first == -1 || possibilities < lessPossibilities) {
+                lessPossibilitiesCell = {row, col};
+                lessPossibilities = possibilities;
+                countTies = 1;
+            } else if (possibilities == lessPossibilities) {
+                // reservoir sampling between the ties
+                countTies += 1;
+                if (std::uniform_int_distribution<int>(0, countTies - 1)(random) == 0) {
+                    lessPossibilitiesCell = {row, col};
+                }
+            }
+        }
+    }
+    return lessPossibilitiesCell;
+}
+
+long long lubySequence(long long i) {
+    long long power = 1;
+    while (power - 1 < i) {
+        power *= 2;
+    }
+    if (power - 1 == i) {
+        return power / 2;
+    }
+    return lubySequence(i - (power / 2 - 1));
+}
+
+SudokuBoard solvePortfolio(SudokuBoard const &board, int firstMember, bool pollStopMessages, bool &cancelled) {
+    bool stopped = false;
+    SudokuBoard solution(0);
+    cancelled = false;
+#pragma omp parallel shared(stopped, solution, cancelled)
+    {
+        const int member = firstMember + omp_get_thread_num();
+        SearchVariant &variant = getSearchVariant();
+        StrategyScheduler &scheduler = getStrategyScheduler(board.getSudokuDimension());
+        // the first member runs the default search, the others are randomized
+        variant.randomized = member > 0;
+        if (variant.randomized) {
+            variant.random.seed(PORTFOLIO_SEED + member);
+            const int valueOrders[] = {VALUE_ORDER_NATURAL, VALUE_ORDER_LCV, VALUE_ORDER_HISTORY};
+            variant.valueOrder = valueOrders[member % 3];
+            scheduler.shuffle(variant.random);
+        }
+
+        long long restart = 1;
+        SearchStack search(board);
+        SolverContext context(stopped);
+        while (!stopped) {
+            const int status = search.run(context, PORTFOLIO_POLL_PERIOD);
+            if (status == SOLVER_SOLVED || status == SOLVER_DEAD_END) {
+#pragma omp critical
+                {
+                    // first finisher : a solution or the proof there is none
+                    if (!stopped) {
+                        stopped = true;
+                        solution = std::move(context.solution);
+                    }
+                }
+                break;
+            }
+
+            if (pollStopMessages && omp_get_thread_num() == 0) {
+                int stopMessage = 0;
+                MPI_Status stopStatus;
+                MPI_Iprobe(0, CUSTOM_MPI_STOP_WORK_TAG, MPI_COMM_WORLD, &stopMessage, &stopStatus);
+                if (stopMessage) {
+                    int stop;
+                    MPI_Recv(&stop, 1, MPI_INT, 0, CUSTOM_MPI_STOP_WORK_TAG, MPI_COMM_WORLD, &stopStatus);
+#pragma omp critical
+                    {
+                        stopped = true;
+                        cancelled = true;
+                    }
+                    break;
+                }
+            }
+
+            if (variant.randomized && search.getExploredNodes() >= lubySequence(restart) * PORTFOLIO_RESTART_BASE) {
+                // restart with other random choices, the history of dead-ends is kept
+                restart += 1;
+                search = SearchStack(board);
+                scheduler.shuffle(variant.random);
+#pragma omp atomic
+                portfolioRestarts += 1;
+            }
+        }
+        variant.randomized = false;
+        variant.valueOrder = VALUE_ORDER;
+    }
+    return solution;
+}
+
+void dispatchPortfolio(std::deque<SudokuBoard> &problemBoards, std::deque<SudokuBoard> &solutionBoards,
+                       int &successWorkerId, int &firstWinnerWorker) {
+    int processId;                              /* Process rank */
+    int countProcess;                           /* Number of processes */
+    MPI_Comm_rank(MPI_COMM_WORLD, &processId);
+    MPI_Comm_size(MPI_COMM_WORLD, &countProcess);
+
+    if (processId == 0) {
+        if (problemBoards.empty()) {
+            return;
+        }
+        if (countProcess == 1) {
+            // no worker, race the portfolio locally
+            bool cancelled;
+            SudokuBoard solution = solvePortfolio(problemBoards.front(), 0, false, cancelled);
+            problemBoards.clear();
+            if (!solution.isEmpty()) {
+                solutionBoards.emplace_back(std::move(solution));
+                successWorkerId = processId;
+                firstWinnerWorker = processId;
+            }
+            return;
+        }
+
+        // every worker races on the whole board
+        for (int workerId = 1; workerId < countProcess; ++workerId) {
+            sendSudokuBoard(problemBoards.front(), workerId, CUSTOM_MPI_POSSIBILITIES_TAG, MPI_COMM_WORLD);
+        }
+        problemBoards.clear();
+
+        // wait the first finisher then stop everyone
+        long long countSolutions;
+        MPI_Status finisherStatus;
+        MPI_Recv(&countSolutions, 1, MPI_LONG_LONG, MPI_ANY_SOURCE, CUSTOM_MPI_IDLE_TAG, MPI_COMM_WORLD, &finisherStatus);
+        if (countSolutions > 0) {
+            successWorkerId = finisherStatus.MPI_SOURCE;
+            std::cout << "[" << processId << "]: " << successWorkerId << " just found a solution !" << std::endl;
+        }
+        int stop = 0;
+        for (int workerId = 1; workerId < countProcess; ++workerId) {
+            if (workerId != finisherStatus.MPI_SOURCE) {
+                MPI_Send(&stop, 1, MPI_INT, workerId, CUSTOM_MPI_STOP_WORK_TAG, MPI_COMM_WORLD);
+            }
+        }
+    } else {
+        SudokuBoard board = receiveSudokuBoard(0, CUSTOM_MPI_POSSIBILITIES_TAG, MPI_COMM_WORLD);
+        board.recountSolvedCells();
+        board.computePossiblesValuesInCells();
+
+        // members are numbered across processes to run distinct variants
+        bool cancelled;
+        SudokuBoard solution = solvePortfolio(board, (processId - 1) * omp_get_max_threads(), true, cancelled);
+        if (cancelled) {
+            return;
+        }
+
+        // inform master process of the end of the race
+        long long countSolutions = solution.isEmpty() ? 0 : 1;
+        MPI_Send(&countSolutions, 1, MPI_LONG_LONG, 0, CUSTOM_MPI_IDLE_TAG, MPI_COMM_WORLD);
         if (!solution.isEmpty()) {
-            return solution;
+            if (DEBUG >= DEBUG_BASE) {
+                std::cout << "[" << processId << "]: a solution has been found :" << std::endl
+                          << solution << std::endl;
+            }
+            solutionBoards.emplace_back(std::move(solution));
+            successWorkerId = processId;
+            firstWinnerWorker = processId;
         }
     }
+}
 
-    return SudokuBoard(0);
+std::vector<CellAssignment> computeBranchAlternatives(SudokuBoard const &board) {
+    std::vector<CellAssignment> alternatives;
+
+    // best cell : less possibilities
+    SearchVariant &variant = getSearchVariant();
+    std::pair<int, int> nextCell = variant.randomized ? nextEmptyCellRandomized(board, variant.random)
+                                                      : board.nextEmptyCellComputed();
+    if (nextCell.first == -1) {
+        return alternatives;
+    }
+    auto const &possibilitiesInCell = board.getPossiblesValuesInCells()[nextCell.first][nextCell.second];
+    for (int possibleValue: possibilitiesInCell) {
+        alternatives.push_back({nextCell.first, nextCell.second, possibleValue});
+    }
+
+    // positions of values in units are required by unit branching and least constraining value ordering,
+    // they are only counted when the alternatives of the best cell may be replaced or ordered
+    std::unique_ptr<UnitsValuesCount> counts;
+    if (BRANCHING_POLICY == BRANCHING_UNIT && alternatives.size() > 2) {
+        counts.reset(new UnitsValuesCount(board));
+
+        // best unit : a value with less possible positions in a row, a column or a block
+        const int n = board.getSudokuDimension();
+        const int size = board.getBlockSize();
+        const int stride = counts->stride;
+        int bestCount = alternatives.size();
+        int bestUnit = -1;
+        int bestValue = 0;
+        for (int i = 0; i < size; ++i) {
+            for (int value = 1; value <= size; ++value) {
+                // unit (row, column, block) index and count of possible positions
+                std::pair<int, int> unitCounts[] = {{i,            counts->rows[i * stride + value]},
+                                                    {size + i,     counts->columns[i * stride + value]},
+                                                    {2 * size + i, counts->blocks[i * stride + value]}};
+                for (auto const &unitCount: unitCounts) {
+                    if (unitCount.second == 0) {
+                        // a missing value without any possible position => dead-end
+                        auto const &missingValues = unitCount.first < size ? board.getPossiblesValuesInRows()[i] :
+                                                    unitCount.first < 2 * size ? board.getPossiblesValuesInColumns()[i]
+                                                                               : board.getPossiblesValuesInBlocks()[i];
+                        if (missingValues.find(value) != missingValues.end()) {
+                            return {};
+                        }
+                    } else if (unitCount.second < bestCount) {
+                        bestCount = unitCount.second;
+                        bestUnit = unitCount.first;
+                        bestValue = value;
+                    }
+                }
+            }
+        }
+
+        if (bestUnit != -1) {
+            // the value has to be set in one of the possible positions of the unit
+            alternatives.clear();
+            for (int position = 0; position < size; ++position) {
+                int row;
+                int col;
+                if (bestUnit < size) {
+                    row = bestUnit;
+                    col = position;
+                } else if (bestUnit < 2 * size) {
+                    row = position;
+                    col = bestUnit - size;
+                } else {
+                    row = ((bestUnit - 2 * size) / n) * n + position / n;
+                    col = ((bestUnit - 2 * size) % n) * n + position % n;
+                }
+                auto const &possibilities = board.getPossiblesValuesInCells()[row][col];
+                if (possibilities.find(bestValue) != possibilities.end()) {
+                    alternatives.push_back({row, col, bestValue});
+                }
+            }
+        }
+    }
+
+    if (!counts && variant.valueOrder == VALUE_ORDER_LCV && alternatives.size() > 1) {
+        counts.reset(new UnitsValuesCount(board));
+    }
+    orderBranchAlternatives(board, counts.get(), alternatives);
+    return alternatives;
+}
+
+void orderBranchAlternatives(SudokuBoard const &board, UnitsValuesCount const *counts,
+                             std::vector<CellAssignment> &alternatives) {
+    SearchVariant &variant = getSearchVariant();
+    if (alternatives.size() < 2) {
+        return;
+    }
+    if (variant.randomized) {
+        // random ties between alternatives
+        std::shuffle(alternatives.begin(), alternatives.end(), variant.random);
+    }
+    if (variant.valueOrder == VALUE_ORDER_NATURAL) {
+        return;
+    }
+
+    // lower score first
+    std::vector<std::pair<long long, CellAssignment>> scoredAlternatives;
+    for (auto const &alternative: alternatives) {
+        long long score = 0;
+        if (variant.valueOrder == VALUE_ORDER_LCV) {
+            // how many candidates are removed by the assignment : the value in the peers
+            // (the cell is counted once in each of its units) and the other values of the cell
+            const int stride = counts->stride;
+            const int block = board.getBlockOfCell(alternative.row, alternative.col);
+            score = counts->rows[alternative.row * stride + alternative.value] +
+                    counts->columns[alternative.col * stride + alternative.value] +
+                    counts->blocks[block * stride + alternative.value] +
+                    board.getPossiblesValuesInCells()[alternative.row][alternative.col].size();
+        } else {
+            // how many times the assignment led to a dead-end
+            auto const &history = getValueOrderHistory(board);
+            score = history[(alternative.row * board.getBlockSize() + alternative.col) * (board.getBlockSize() + 1) +
+                            alternative.value];
+        }
+        scoredAlternatives.emplace_back(score, alternative);
+    }
+    std::stable_sort(scoredAlternatives.begin(), scoredAlternatives.end(),
+                     [](std::pair<long long, CellAssignment> const &a, std::pair<long long, CellAssignment> const &b) {
+                         return a.first < b.first;
+                     });
+    for (int i = 0; i < (int) alternatives.size(); ++i) {
+        alternatives[i] = scoredAlternatives[i].second;
+    }
+}
+
+std::vector<int> &getValueOrderHistory(SudokuBoard const &board) {
+    auto &history = valueOrderHistories.at(omp_get_thread_num());
+    const std::size_t historySize = board.getSize() * (board.getBlockSize() + 1);
+    if (history.size() != historySize) {
+        history.assign(historySize, 0);
+    }
+    return history;
+}
+
+void recordFailedAlternative(SudokuBoard const &board, CellAssignment const &alternative) {
+    if (getSearchVariant().valueOrder != VALUE_ORDER_HISTORY) {
+        return;
+    }
+    auto &history = getValueOrderHistory(board);
+    history[(alternative.row * board.getBlockSize() + alternative.col) * (board.getBlockSize() + 1) +
+            alternative.value] += 1;
+}
+
+UnitsValuesCount::UnitsValuesCount(SudokuBoard const &board) : stride(board.getBlockSize() + 1),
+                                                               rows(board.getBlockSize() * stride, 0),
+                                                               columns(board.getBlockSize() * stride, 0),
+                                                               blocks(board.getBlockSize() * stride, 0) {
+    for (int row = 0; row < board.countRows(); ++row) {
+        for (int col = 0; col < board.countColumns(); ++col) {
+            const int block = board.getBlockOfCell(row, col);
+            for (int possibleValue: board.getPossiblesValuesInCells()[row][col]) {
+                rows[row * stride + possibleValue] += 1;
+                columns[col * stride + possibleValue] += 1;
+                blocks[block * stride + possibleValue] += 1;
+            }
+        }
+    }
 }
 
-SudokuBoard solveReduceCrook(SudokuBoard &board, bool &solutionFound) {
+int solveReduceCrook(SudokuBoard &board, bool const &solutionFound) {
     if (!board.isComputedPossibleValues()) {
         throw std::invalid_argument(
                 "Given front board have no pre-computation over possibles values. Please use `computePossibleValues` first.");
     }
-    // apply humanistic heuristic
-    int changedElimination = 0;
-    int changedLoneRangers = 0;
-    int changedTwins = 0;
-    int changedTriplets = 0;
+    // apply humanistic heuristic, strategies are ordered by the scheduler of the thread
+    StrategyScheduler &scheduler = getStrategyScheduler(board.getSudokuDimension());
+    int changed = 0;
+    // the searches check the budgets and the stop requests between their nodes, only a long propagation checks them
+    long long rounds = 0;
     do {
-        if (solutionFound) {
+        if (solutionFound ||
+            (++rounds % BUDGET_CHECK_PERIOD == 0 && (checkBudget() != BUDGET_NONE || checkStopWork()))) {
             board = SudokuBoard(0);
-            return board;
-        }
-        changedElimination = eliminatationStrategy(board);
-        if (board.isSolved()) {
-            return board;
-        }
-        if (changedElimination > 0) {
-            //  std::cout << "ELIMINATION = " << changedElimination << std::endl;
-            continue;
+            return SOLVER_CANCELLED;
         }
-        if (changedElimination == -1) {
+        changed = scheduler.applyStrategies(board);
+        if (changed == -1) {
             board = SudokuBoard(0);
-            return board;
+            return SOLVER_DEAD_END;
         }
-
-        changedLoneRangers = lonerangerStrategy(board);
         if (board.isSolved()) {
-            return board;
-        }
-        if (changedLoneRangers > 0) {
-            // std::cout << "LONE RANGERS = " << changedLoneRangers << std::endl;
-            continue;
-        }
-        if (changedLoneRangers == -1) {
-            board = SudokuBoard(0);
-            return board;
+            return SOLVER_SOLVED;
         }
+    } while (changed > 0);
 
+    return SOLVER_OPEN;
+}
 
-        changedTwins = twinsStrategy(board);
-        if (changedTwins > 0) {
-            // std::cout << "TWINS = " << changedTwins << std::endl;
-            continue;
+double estimateFrontierCost(SudokuBoard const &board) {
+    if (FRONTIER_POLICY == FRONTIER_LOG_PRODUCT) {
+        return logProductOfCandidates(board);
+    }
+    if (board.isTrackingEmptyCells()) {
+        return board.getEmptyCells().size();
+    }
+    double estimate = 0;
+    for (int row = 0; row < board.countRows(); ++row) {
+        for (int col = 0; col < board.countColumns(); ++col) {
+            if (board.get(row, col) == 0) {
+                estimate += 1;
+            }
         }
+    }
+    return estimate;
+}
 
-        changedTriplets = tripletsStrategy(board);
-        if (changedTriplets > 0) {
-            // std::cout << "TRIPLETS = " << changedTwins << std::endl;
+double logProductOfCandidates(SudokuBoard const &board) {
+    double estimate = 0;
+    if (board.isTrackingEmptyCells()) {
+        for (int cell: board.getEmptyCells()) {
+            const std::size_t countPossibilities =
+                    board.getPossiblesValuesInCells()[cell / board.countColumns()][cell % board.countColumns()].size();
+            estimate += countPossibilities > 0 ? std::log2((double) countPossibilities) : 0;
         }
-    } while (changedElimination > 0 || changedLoneRangers > 0 || changedTwins > 0 || changedTriplets > 0);
-
-    return SudokuBoard(0);
+        return estimate;
+    }
+    for (int row = 0; row < board.countRows(); ++row) {
+        for (int col = 0; col < board.countColumns(); ++col) {
+            if (board.get(row, col) != 0) {
+                continue;
+            }
+            const std::size_t countPossibilities = board.getPossiblesValuesInCells()[row][col].size();
+            estimate += countPossibilities > 0 ? std::log2((double) countPossibilities) : 0;
+        }
+    }
+    return estimate;
 }
 
-SudokuBoard generatePossibilitiesNextCell(std::deque<SudokuBoard> &boardsToWork) {
-    if (boardsToWork.empty()) {
-        // no solution remaining
-        throw std::invalid_argument("Given boards to compute is empty, no reduction can be done.");
+double probeSubtreeCost(SudokuBoard const &board, int countProbes) {
+    std::mt19937_64 random(board.getZobristHash());
+    double sumEstimates = 0;
+    for (int probe = 0; probe < countProbes; ++probe) {
+        SudokuBoard node = board;
+        // nodes at the current depth and in the whole tree, as seen from the walk
+        double width = 1;
+        double estimate = 1;
+        auto cell = node.nextEmptyCellComputed();
+        while (cell.first != -1) {
+            auto const &possibilities = node.getPossiblesValuesInCells()[cell.first][cell.second];
+            if (possibilities.empty() || width > 1e300) {
+                // dead-end, or an estimate out of range of the doubles
+                break;
+            }
+            width *= possibilities.size();
+            estimate += width;
+            auto value = possibilities.begin();
+            std::advance(value, random() % possibilities.size());
+            node.setValueAndUpdatePossibilities(cell.first, cell.second, *value);
+            cell = node.nextEmptyCellComputed();
+        }
+        sumEstimates += estimate;
     }
+    return std::log2(sumEstimates / countProbes);
+}
 
-    SudokuBoard &workingBoard = boardsToWork.front();
+double estimateSubtreeCost(SudokuBoard const &board) {
+    if (DISPATCH_ORDER == DISPATCH_ORDER_PROBE) {
+        return probeSubtreeCost(board, COST_PROBES);
+    }
+    return logProductOfCandidates(board);
+}
 
-    bool stopped = false;
-    solveReduceCrook(workingBoard, stopped);
+void orderByExpectedCost(std::deque<SudokuBoard> &boards) {
+    if (DISPATCH_ORDER == DISPATCH_ORDER_FIFO) {
+        return;
+    }
+    for (auto &board: boards) {
+        if (board.isEmpty()) {
+            continue;
+        }
+        if (!board.isComputedPossibleValues()) {
+            board.recountSolvedCells();
+            board.computePossiblesValuesInCells();
+        }
+        board.setCostEstimate(estimateSubtreeCost(board));
+    }
+    std::stable_sort(boards.begin(), boards.end(), [](SudokuBoard const &a, SudokuBoard const &b) {
+        return a.getCostEstimate() > b.getCostEstimate();
+    });
+}
 
-    auto nextEmptyCell = workingBoard.nextEmptyCell();
+bool hasLowerCostEstimate(SudokuBoard const &a, SudokuBoard const &b) {
+    return a.getCostEstimate() < b.getCostEstimate();
+}
 
-    // all cells have a value, we found a solution,
-    // add it to the solutions list, JOB IS DONE !
-    if (nextEmptyCell.first == -1) {
-        SudokuBoard solution = workingBoard;
+SudokuBoard popFrontierBoard(std::deque<SudokuBoard> &boardsToWork) {
+    // work the front board, or the largest one
+    SudokuBoard board(0);
+    if (FRONTIER_POLICY == FRONTIER_FIFO) {
+        board = std::move(boardsToWork.front());
         boardsToWork.pop_front();
-        return solution;
+    } else {
+        std::pop_heap(boardsToWork.begin(), boardsToWork.end(), hasLowerCostEstimate);
+        board = std::move(boardsToWork.back());
+        boardsToWork.pop_back();
     }
+    return board;
+}
+
+void pushFrontierBoard(std::deque<SudokuBoard> &boardsToWork, SudokuBoard &&board) {
+    boardsToWork.emplace_back(std::move(board));
+    if (FRONTIER_POLICY != FRONTIER_FIFO) {
+        // best-first frontier is a heap on the cost estimates of the boards
+        std::push_heap(boardsToWork.begin(), boardsToWork.end(), hasLowerCostEstimate);
+    }
+}
 
+int expandFrontierBoard(SudokuBoard &workingBoard, std::vector<SudokuBoard> &children) {
+    const bool stopped = false;
+    const int status = solveReduceCrook(workingBoard, stopped);
+    if (status != SOLVER_OPEN) {
+        // all cells have a value, we found a solution, JOB IS DONE ! or no solution for this board, next!
+        return status;
+    }
+    recordPartialBoard(workingBoard);
 
+    auto nextEmptyCell = workingBoard.nextEmptyCell();
     auto const &possiblesValuesInCell = workingBoard.getPossiblesValuesInCells()[nextEmptyCell.first][nextEmptyCell.second];
     if (possiblesValuesInCell.empty()) {
         // no solution for this board, next!
-        boardsToWork.pop_front();
-        return SudokuBoard(0);
+        return SOLVER_DEAD_END;
     }
 
     // create a new board to check for each possible value
-    // and add it to the work queue
     for (auto const &value: possiblesValuesInCell) {
         SudokuBoard copyBoard = workingBoard;
         copyBoard.setValueAndUpdatePossibilities(nextEmptyCell.first, nextEmptyCell.second, value);
+        if (FRONTIER_POLICY != FRONTIER_FIFO) {
+            copyBoard.setCostEstimate(estimateFrontierCost(copyBoard));
+        }
+        children.emplace_back(std::move(copyBoard));
+    }
+
+    return SOLVER_OPEN;
+}
+
+SudokuBoard generatePossibilitiesNextCell(std::deque<SudokuBoard> &boardsToWork) {
+    if (boardsToWork.empty()) {
+        // no solution remaining
+        throw std::invalid_argument("Given boards to compute is empty, no reduction can be done.");
+    }
 
-        boardsToWork.emplace_back(std::move(copyBoard));
+    SudokuBoard workingBoard = popFrontierBoard(boardsToWork);
+    std::vector<SudokuBoard> children;
+    if (expandFrontierBoard(workingBoard, children) == SOLVER_SOLVED) {
+        return workingBoard;
     }
 
-    boardsToWork.pop_front();
+    // add the new boards to the work queue
+    for (auto &child: children) {
+        pushFrontierBoard(boardsToWork, std::move(child));
+    }
 
     return SudokuBoard(0);
 }
 
-SudokuBoard solveProblemsOnNode(std::deque<SudokuBoard> &problems) {
+std::vector<SudokuBoard> generatePossibilitiesInParallel(std::deque<SudokuBoard> &boardsToWork, int countBoards) {
+    if (boardsToWork.empty()) {
+        // no solution remaining
+        throw std::invalid_argument("Given boards to compute is empty, no reduction can be done.");
+    }
+
+    std::vector<SudokuBoard> workingBoards;
+    while (!boardsToWork.empty() && (int) workingBoards.size() < countBoards) {
+        workingBoards.emplace_back(popFrontierBoard(boardsToWork));
+    }
+
+    // each board is reduced and split by a thread
+    std::vector<int> statuses(workingBoards.size(), SOLVER_OPEN);
+    std::vector<std::vector<SudokuBoard>> children(workingBoards.size());
+#pragma omp parallel for schedule(dynamic, 1)
+    for (int i = 0; i < (int) workingBoards.size(); ++i) {
+        statuses[i] = expandFrontierBoard(workingBoards[i], children[i]);
+    }
+
+    // add the new boards to the work queue in the order of their parents
+    std::vector<SudokuBoard> foundSolutions;
+    for (int i = 0; i < (int) workingBoards.size(); ++i) {
+        if (statuses[i] == SOLVER_SOLVED) {
+            foundSolutions.emplace_back(std::move(workingBoards[i]));
+        }
+        for (auto &child: children[i]) {
+            pushFrontierBoard(boardsToWork, std::move(child));
+        }
+    }
+    return foundSolutions;
+}
+
+int solveProblemsOnNode(std::deque<SudokuBoard> &problems, SolutionCounter *counter, SolverContext &context) {
     int processId;                              /* Process rank */
     int countProcess;                           /* Number of processes */
     MPI_Comm_rank(MPI_COMM_WORLD, &processId);
@@ -432,12 +2312,25 @@ SudokuBoard solveProblemsOnNode(std::deque<SudokuBoard> &problems) {
     // generate sub-problems in order to dispatch work between threads
     problems.front().recountSolvedCells();
     problems.front().computePossiblesValuesInCells();
-    while (!problems.empty() && problems.size() < COUNT_PROBLEMS_TO_GENERATE_ON_WORKER) {
+
+    // estimates of the costs are logged against the search times to calibrate them
+    const bool logCosts = DEBUG >= DEBUG_BASE && DISPATCH_ORDER != DISPATCH_ORDER_FIFO;
+    const double receivedCost = logCosts && problems.size() == 1 ? estimateSubtreeCost(problems.front()) : 0;
+    const double searchStart = omp_get_wtime();
+    bool solutionFound = false;
+    std::deque<SudokuBoard> solutions;
+    while (!solutionFound && !problems.empty() && (int) problems.size() < COUNT_PROBLEMS_TO_GENERATE_ON_WORKER &&
+           checkBudget() == BUDGET_NONE) {
         SudokuBoard solution = generatePossibilitiesNextCell(problems);
 
         if (!solution.isEmpty()) {
             // solution found during generation
-            return solution;
+            if (counter == nullptr) {
+                context.solution = std::move(solution);
+                context.status = SOLVER_SOLVED;
+                return context.status;
+            }
+            countSolution(solution, solutionFound, solutions, *counter);
         }
     }
 
@@ -445,16 +2338,121 @@ SudokuBoard solveProblemsOnNode(std::deque<SudokuBoard> &problems) {
         std::cout << "[" << processId << "]: generated " << problems.size() << " problem boards to check." << std::endl;
     }
 
-    bool solutionFound = false;
-    std::deque<SudokuBoard> solutions;
+    // start the longest expected problems first
+    orderByExpectedCost(problems);
+
+    if (DETERMINISTIC) {
+        // a solution only stops the problems after it, the solution of the lowest index wins
+        std::unique_ptr<bool[]> stops(new bool[problems.size()]());
+        std::vector<long long> problemNodes(problems.size(), 0);
+        int winner = problems.size();
+        int finishedThreads = 0;
+#pragma omp parallel shared(stops, problemNodes, winner, solutions, problems, counter, finishedThreads)
+        {
+#pragma omp for schedule(dynamic, 1) nowait
+            for (int i = 0; i < (int) problems.size(); ++i) {
+                if (stops[i]) {
+                    continue;
+                }
+                SolverContext taskContext(stops[i]);
+                if (TREE_SEARCH == TREE_SEARCH_LDS && counter == nullptr) {
+                    solveLimitedDiscrepancy(problems[i], taskContext);
+                } else {
+                    SearchStack search(problems[i]);
+                    while (search.run(taskContext, -1) == SOLVER_SOLVED && counter != nullptr) {
+                        // go on exploring the tree
+                        countSolution(taskContext.solution, stops[i], solutions, *counter);
+                    }
+                }
+                problemNodes[i] = taskContext.nodes;
+                if (taskContext.status == SOLVER_SOLVED && counter == nullptr) {
+#pragma omp critical
+                    {
+                        if (i < winner) {
+                            winner = i;
+                            solutions.clear();
+                            solutions.emplace_back(std::move(taskContext.solution));
+                            for (int j = i + 1; j < (int) problems.size(); ++j) {
+                                stops[j] = true;
+                            }
+                        }
+                    }
+                }
+            }
+            finishSearchesPollingStopWork(finishedThreads);
+        }
+        for (int i = 0; i < (int) problems.size() && i <= winner; ++i) {
+            orderedSearchNodes += problemNodes[i];
+        }
+        problems.clear();
+        if (solutions.empty()) {
+            context.status = checkBudget() != BUDGET_NONE ? SOLVER_TIMEOUT : SOLVER_DEAD_END;
+            return context.status;
+        }
+        context.solution = std::move(solutions.front());
+        context.status = SOLVER_SOLVED;
+        return context.status;
+    }
+
+    if (TREE_SEARCH == TREE_SEARCH_LDS_PARALLEL && counter == nullptr) {
+        // each thread takes the next discrepancy limit and explores all the problems with it
+        int nextLimit = 0;
+        int finishedThreads = 0;
+#pragma omp parallel shared(solutionFound, solutions, problems, nextLimit, finishedThreads)
+        {
+            while (!solutionFound) {
+                int limit;
+#pragma omp atomic capture
+                limit = nextLimit++;
+
+                bool allExhausted = true;
+                SolverContext threadContext(solutionFound);
+                for (int i = 0; i < (int) problems.size() && !solutionFound; ++i) {
+                    bool exhausted;
+                    if (solveWithDiscrepancies(problems[i], limit, threadContext, exhausted) == SOLVER_SOLVED) {
+#pragma omp critical
+                        {
+                            solutionFound = true;
+                            solutions.emplace_back(std::move(threadContext.solution));
+                        }
+                    }
+                    allExhausted = allExhausted && exhausted;
+                }
+                if (allExhausted) {
+                    // the whole search trees have been explored without solution, stop everyone
+#pragma omp critical
+                    solutionFound = true;
+                }
+            }
+            finishSearchesPollingStopWork(finishedThreads);
+        }
+        problems.clear();
+        if (solutions.empty()) {
+            context.status = checkBudget() != BUDGET_NONE ? SOLVER_TIMEOUT : SOLVER_DEAD_END;
+            return context.status;
+        }
+        context.solution = std::move(solutions.front());
+        context.status = SOLVER_SOLVED;
+        return context.status;
+    }
+
+    int queuedTasks = 0;
+    // created tasks not finished yet, including the parts of the searches given to other threads
+    int unfinishedTasks = 0;
 // creating tasks pool
-#pragma omp parallel shared(solutionFound, solutions, problems)
+#pragma omp parallel shared(solutionFound, solutions, problems, queuedTasks, unfinishedTasks, counter)
     {
 #pragma omp single nowait
         {
             for (int i = 0; i < problems.size(); ++i) {
+#pragma omp atomic
+                queuedTasks += 1;
+#pragma omp atomic
+                unfinishedTasks += 1;
 #pragma omp task
                 {
+#pragma omp atomic
+                    queuedTasks -= 1;
                     if (!solutionFound) {
                         // we can't break loop :( beurk OpenMP 3, vive OpenMP 5
 
@@ -464,36 +2462,175 @@ SudokuBoard solveProblemsOnNode(std::deque<SudokuBoard> &problems) {
                                       << " threads." << std::endl;
                         }
 
-                        // update existing values
-                        SudokuBoard solution = solveBoard(problems[i], solutionFound);
-
-                        if (!solution.isEmpty()) {
+                        const double taskStart = omp_get_wtime();
+                        solveProblemTask(problems[i], solutionFound, solutions, queuedTasks, unfinishedTasks,
+                                         counter);
+                        if (logCosts) {
+                            // the parts of the search given to other threads are not timed here
 #pragma omp critical
-                            {
-                                // see : http://jakascorner.com/blog/2016/08/omp-cancel.html
-                                solutionFound = true;
-                                solutions.emplace_back(std::move(solution));
-                            }
-                          /**  std::cout << "[" << processId << "]{" << omp_get_thread_num()
-                                      << "}: found a solution, the programm should stop." << std::endl; **/
+                            std::cout << "[" << processId << "]{" << omp_get_thread_num()
+                                      << "}: problem board with estimated cost " << problems[i].getCostEstimate()
+                                      << " searched in " << omp_get_wtime() - taskStart << " seconds." << std::endl;
                         }
                     }
+#pragma omp atomic
+                    unfinishedTasks -= 1;
                 }
             }
+            if (pollStopWork && omp_get_num_threads() > 1) {
+                // the main thread may wait at the barrier while the others search : keep polling from a task
+#pragma omp task
+                pollStopWorkTask(queuedTasks, unfinishedTasks);
+            }
         }
     }
 
+    if (logCosts && receivedCost > 0) {
+        std::cout << "[" << processId << "]: received problem board with estimated cost " << receivedCost
+                  << " searched in " << omp_get_wtime() - searchStart << " seconds." << std::endl;
+    }
+
     // clear problems
     problems.clear();
 
     if (!solutions.empty()) {
       /**  std::cout << "[" << processId << "]{" << omp_get_thread_num() << "}: found a solution, returning..."
                   << std::endl; **/
-        return solutions.front();
+        context.solution = std::move(solutions.front());
+        context.status = SOLVER_SOLVED;
+        return context.status;
     }
 
-    // no solution found
-    return SudokuBoard(0);
+    // no solution found, or not within the budget
+    context.status = checkBudget() != BUDGET_NONE ? SOLVER_TIMEOUT : SOLVER_DEAD_END;
+    return context.status;
+}
+
+void solveProblemTask(SudokuBoard const &board, bool &solutionFound, std::deque<SudokuBoard> &solutions,
+                      int &queuedTasks, int &unfinishedTasks, SolutionCounter *counter) {
+    SolverContext context(solutionFound);
+    if (TREE_SEARCH == TREE_SEARCH_LDS && counter == nullptr) {
+        if (solveLimitedDiscrepancy(board, context) == SOLVER_SOLVED) {
+#pragma omp critical
+            {
+                solutionFound = true;
+                solutions.emplace_back(std::move(context.solution));
+            }
+        }
+        return;
+    }
+
+    SearchStack search(board);
+    while (!solutionFound && !search.isExhausted()) {
+        const int status = search.run(context, SEARCH_SPLIT_PERIOD > 0 ? SEARCH_SPLIT_PERIOD : -1);
+        if (status == SOLVER_SOLVED && counter != nullptr) {
+            // go on exploring the tree
+            countSolution(context.solution, solutionFound, solutions, *counter);
+            continue;
+        }
+        if (status == SOLVER_SOLVED) {
+#pragma omp critical
+            {
+                // see : http://jakascorner.com/blog/2016/08/omp-cancel.html
+                solutionFound = true;
+                solutions.emplace_back(std::move(context.solution));
+            }
+            return;
+        }
+
+        // no task waiting to be scheduled, some threads may be idle : give them a part of the search
+        int waitingTasks;
+#pragma omp atomic read
+        waitingTasks = queuedTasks;
+        if (waitingTasks > 0 || search.isExhausted()) {
+            continue;
+        }
+        std::deque<SudokuBoard> givenBoards;
+        if (search.split(givenBoards) == 0) {
+            continue;
+        }
+#pragma omp atomic
+        searchSplits += 1;
+        // the tasks may outlive this call, share the state through pointers
+        bool *sharedSolutionFound = &solutionFound;
+        std::deque<SudokuBoard> *sharedSolutions = &solutions;
+        int *sharedQueuedTasks = &queuedTasks;
+        int *sharedUnfinishedTasks = &unfinishedTasks;
+        SolutionCounter *sharedCounter = counter;
+        while (!givenBoards.empty()) {
+            SudokuBoard givenBoard = std::move(givenBoards.front());
+            givenBoards.pop_front();
+#pragma omp atomic
+            queuedTasks += 1;
+#pragma omp atomic
+            unfinishedTasks += 1;
+#pragma omp task firstprivate(givenBoard, sharedSolutionFound, sharedSolutions, sharedQueuedTasks, \
+                              sharedUnfinishedTasks, sharedCounter)
+            {
+#pragma omp atomic
+                *sharedQueuedTasks -= 1;
+                if (!*sharedSolutionFound) {
+                    solveProblemTask(givenBoard, *sharedSolutionFound, *sharedSolutions, *sharedQueuedTasks,
+                                     *sharedUnfinishedTasks, sharedCounter);
+                }
+#pragma omp atomic
+                *sharedUnfinishedTasks -= 1;
+            }
+        }
+    }
+}
+
+void countSolution(SudokuBoard &solution, bool &solutionFound, std::deque<SudokuBoard> &solutions,
+                   SolutionCounter &counter) {
+    BoardConflict conflict;
+    if (solution.findFirstConflict(conflict)) {
+        std::cerr << "ERROR : an invalid solution has been found (" << conflict << "), it is not counted."
+                  << std::endl;
+        return;
+    }
+    const long long countOnThread = counter.add();
+    if (counter.isLimitReached()) {
+        // limit reached, stop the search
+        solutionFound = true;
+    }
+    if (countOnThread == 1) {
+#pragma omp critical
+        {
+            // keep the first solution
+            if (solutions.empty()) {
+                solutions.emplace_back(std::move(solution));
+            }
+        }
+    }
+}
+
+SolutionCounter::SolutionCounter(long long limit) : counts(omp_get_max_threads()), limit(limit) {
+    for (auto &count: counts) {
+        count.value = 0;
+    }
+}
+
+long long SolutionCounter::add() {
+    long long &count = counts.at(omp_get_thread_num()).value;
+    long long countOnThread;
+#pragma omp atomic capture
+    countOnThread = ++count;
+    return countOnThread;
+}
+
+long long SolutionCounter::total() const {
+    long long total = 0;
+    for (auto const &count: counts) {
+        long long value;
+#pragma omp atomic read
+        value = count.value;
+        total += value;
+    }
+    return total;
+}
+
+bool SolutionCounter::isLimitReached() const {
+    return limit > 0 && total() >= limit;
 }
 
 void SudokuBoard::addPossibleValueForCell(int row, int col, int value) {
@@ -503,35 +2640,64 @@ void SudokuBoard::addPossibleValueForCell(int row, int col, int value) {
            << getBlockSize() << ".";
         throw std::invalid_argument(ss.str());
     }
-    this->getPossiblesValuesInCells()[row][col].insert(value);
-    this->getPossiblesValuesInRows()[row].insert(value);
-    this->getPossiblesValuesInColumns()[col].insert(value);
-    this->getPossiblesValuesInBlocks()[this->getBlockOfCell(row, col)].insert(value);
+    this->editPossiblesValuesInCell(row, col).insert(value);
+    this->possiblesValuesInRows.edit(row).insert(value);
+    this->possiblesValuesInColumns.edit(col).insert(value);
+    this->possiblesValuesInBlocks.edit(this->getBlockOfCell(row, col)).insert(value);
 
 }
 
-void SudokuBoard::removePossibleValueForCell(int row, int col, int value) {
-    this->getPossiblesValuesInCells()[row][col].erase(value);
+int SudokuBoard::removePossibleValueForCell(int row, int col, int value) {
+    if (this->getPossiblesValuesInCells()[row][col].count(value) == 0) {
+        // keep sharing the row
+        return 0;
+    }
+    return this->editPossiblesValuesInCell(row, col).erase(value);
 }
 
 void SudokuBoard::setValueAndUpdatePossibilities(int row, int col, int value) {
+    const int cell = row * this->getRowSize() + col;
+    if (this->get(row, col) == 0) {
+        this->setCountSolvedCells(this->getCountSolvedCells() + 1);
+        if (isTrackingEmptyCells()) {
+            // swap-remove the cell from the empty cells
+            const int position = this->emptyCellPositions[cell];
+            const int lastCell = this->emptyCells.back();
+            this->emptyCells[position] = lastCell;
+            this->emptyCellPositions[lastCell] = position;
+            this->emptyCells.pop_back();
+            this->emptyCellPositions[cell] = -1;
+        }
+    } else {
+        this->zobristHash ^= zobristKey(cell, this->get(row, col));
+    }
+    this->zobristHash ^= zobristKey(cell, value);
     this->operator[](row)[col] = value;
-    this->setCountSolvedCells(this->getCountSolvedCells() + 1);
-    this->getPossiblesValuesInCells()[row][col].clear();
-    this->getPossiblesValuesInRows()[row].erase(value);
-    this->getPossiblesValuesInColumns()[col].erase(value);
-    this->getPossiblesValuesInBlocks()[this->getBlockOfCell(row, col)].erase(value);
+    if (!this->getPossiblesValuesInCells()[row][col].empty()) {
+        this->editPossiblesValuesInCell(row, col).clear();
+    }
+    // keep sharing the units where the value was already set
+    if (this->possiblesValuesInRows[row].count(value) != 0) {
+        this->possiblesValuesInRows.edit(row).erase(value);
+    }
+    if (this->possiblesValuesInColumns[col].count(value) != 0) {
+        this->possiblesValuesInColumns.edit(col).erase(value);
+    }
+    const int block = this->getBlockOfCell(row, col);
+    if (this->possiblesValuesInBlocks[block].count(value) != 0) {
+        this->possiblesValuesInBlocks.edit(block).erase(value);
+    }
 
-    // update possibillities in each cell
+    // update possibillities in each cell, only the rows of the cells where the value was possible are edited
     for (int i = 0; i < countRows(); ++i) {
-        getPossiblesValuesInCells()[row][i].erase(value);
-        getPossiblesValuesInCells()[i][col].erase(value);
+        removePossibleValueForCell(row, i, value);
+        removePossibleValueForCell(i, col, value);
     }
     const int initBlockRow = this->getStartingRowBlockOfCell(row);
     const int initBlockCol = this->getStartingColBlockOfCell(col);
     for (int k = 0; k < this->getSudokuDimension(); ++k) {
         for (int p = 0; p < this->getSudokuDimension(); ++p) {
-            getPossiblesValuesInCells()[initBlockRow + k][initBlockCol + p].erase(value);
+            removePossibleValueForCell(initBlockRow + k, initBlockCol + p, value);
         }
     }
 }
@@ -599,6 +2765,241 @@ bool SudokuBoard::testValueInCell(int row, int col, int value) const {
     return true;
 }
 
+StrategyRecord::StrategyRecord(std::string name, int (*apply)(SudokuBoard &), bool pinned) : name(std::move(name)),
+                                                                                               apply(apply),
+                                                                                               pinned(pinned) {}
+
+StrategyScheduler::StrategyScheduler(int dimension) : dimension(dimension) {
+    // default order, elimination is always applied first
+    strategies.emplace_back("elimination", eliminatationStrategy, true);
+    strategies.emplace_back("lone rangers", lonerangerStrategy, false);
+    strategies.emplace_back("locked candidates", lockedCandidatesStrategy, false);
+    strategies.emplace_back("twins", twinsStrategy, false);
+    strategies.emplace_back("triplets", tripletsStrategy, false);
+    if (isFishStrategyEnabled(dimension)) {
+        strategies.emplace_back("fish", configuredFishStrategy, false);
+    }
+}
+
+int StrategyScheduler::applyStrategies(SudokuBoard &board) {
+    passes += 1;
+    if (ADAPTIVE_SCHEDULER && passes % SCHEDULER_REORDER_PERIOD == 0) {
+        reorder();
+    }
+
+    // the strategies are timed for the adaptive order and the statistics only
+    const bool timed = ADAPTIVE_SCHEDULER || STATS_OUTPUT != STATS_OFF || DEBUG >= DEBUG_BASE;
+    for (auto &strategy: strategies) {
+        if (ADAPTIVE_SCHEDULER && !strategy.pinned && strategy.skipsRemaining > 0) {
+            // strategy is backing off
+            strategy.skipsRemaining -= 1;
+            strategy.skips += 1;
+            continue;
+        }
+
+        const int solvedCellsBefore = board.getCountSolvedCells();
+        int changed;
+        if (timed) {
+            std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+            changed = strategy.apply(board);
+            std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+            strategy.nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+        } else {
+            changed = strategy.apply(board);
+        }
+        strategy.calls += 1;
+
+        if (changed != 0) {
+            if (changed > 0) {
+                strategy.eliminations += changed;
+                if (STATS_OUTPUT != STATS_OFF) {
+                    strategy.placements += board.getCountSolvedCells() - solvedCellsBefore;
+                }
+            }
+            strategy.failures = 0;
+            strategy.backoff = 0;
+            return changed;
+        }
+
+        strategy.failures += 1;
+        if (strategy.failures >= SCHEDULER_BACKOFF_FAILURES) {
+            // too many failures, skip the strategy for a while
+            strategy.backoff = std::min(strategy.backoff + 1, SCHEDULER_MAX_BACKOFF);
+            strategy.skipsRemaining = 1 << strategy.backoff;
+            strategy.failures = 0;
+        }
+    }
+
+    return 0;
+}
+
+void StrategyScheduler::reorder() {
+    // pinned strategies stay at the beginning
+    std::stable_sort(strategies.begin(), strategies.end(), [](StrategyRecord const &a, StrategyRecord const &b) {
+        if (a.pinned != b.pinned) {
+            return a.pinned;
+        }
+        // compare eliminations per nanosecond
+        return (double) a.eliminations * (double) (b.nanoseconds + 1) >
+               (double) b.eliminations * (double) (a.nanoseconds + 1);
+    });
+}
+
+int StrategyScheduler::getDimension() const {
+    return dimension;
+}
+
+std::vector<StrategyRecord> const &StrategyScheduler::getStrategies() const {
+    return strategies;
+}
+
+void StrategyScheduler::shuffle(std::mt19937_64 &random) {
+    // pinned strategies stay at the beginning
+    auto firstNotPinned = std::partition(strategies.begin(), strategies.end(),
+                                         [](StrategyRecord const &strategy) { return strategy.pinned; });
+    std::shuffle(firstNotPinned, strategies.end(), random);
+}
+
+StrategyScheduler &getStrategyScheduler(int dimension) {
+    auto &schedulers = strategySchedulers.at(omp_get_thread_num());
+    auto scheduler = schedulers.find(dimension);
+    if (scheduler == schedulers.end()) {
+        scheduler = schedulers.emplace(dimension, StrategyScheduler(dimension)).first;
+    }
+    return scheduler->second;
+}
+
+void printStrategySchedulers(int processId) {
+    // sum statistics of every thread by dimension and strategy
+    std::map<int, std::map<std::string, StrategyRecord>> totals;
+    for (int thread = 0; thread < (int) strategySchedulers.size(); ++thread) {
+        for (auto const &scheduler: strategySchedulers[thread]) {
+            std::stringstream order;
+            for (auto const &strategy: scheduler.second.getStrategies()) {
+                order << (strategy.pinned ? "" : " > ") << strategy.name;
+
+                auto total = totals[scheduler.first].emplace(strategy.name, strategy);
+                if (!total.second) {
+                    total.first->second.calls += strategy.calls;
+                    total.first->second.skips += strategy.skips;
+                    total.first->second.eliminations += strategy.eliminations;
+                    total.first->second.nanoseconds += strategy.nanoseconds;
+                }
+            }
+            std::cout << "[" << processId << "]{" << thread << "}: N=" << scheduler.first << " strategies order : "
+                      << order.str() << std::endl;
+        }
+    }
+
+    for (auto const &dimension: totals) {
+        std::cout << "[" << processId << "]: N=" << dimension.first << std::endl;
+        std::cout << std::setfill(' ') << std::left << std::setw(20) << "strategy" << std::right << std::setw(12)
+                  << "calls" << std::setw(12) << "skips" << std::setw(14) << "eliminations" << std::setw(12)
+                  << "time [ms]" << std::setw(12) << "ns/call" << std::endl;
+        for (auto const &strategy: dimension.second) {
+            std::cout << std::left << std::setw(20) << strategy.first << std::right << std::setw(12)
+                      << strategy.second.calls << std::setw(12) << strategy.second.skips << std::setw(14)
+                      << strategy.second.eliminations << std::setw(12) << strategy.second.nanoseconds / 1000000
+                      << std::setw(12) << (strategy.second.calls ? strategy.second.nanoseconds / strategy.second.calls : 0)
+                      << std::endl;
+        }
+    }
+}
+
+void reportStatistics(int processId) {
+    // strategies in the default order of the schedulers, the fish strategy is only scheduled on large boards,
+    // then the all-different filtering
+    std::vector<std::string> names;
+    const StrategyScheduler defaultScheduler(0);
+    for (auto const &strategy: defaultScheduler.getStrategies()) {
+        names.push_back(strategy.name);
+    }
+    if (std::find(names.begin(), names.end(), "fish") == names.end()) {
+        names.emplace_back("fish");
+    }
+    names.emplace_back("all-different");
+    // by strategy : calls, skips, eliminations, placements and nanoseconds,
+    // then search nodes, backtracks, dead ends, kernel nodes and threads, the maximums are reduced apart
+    const int countStrategyFields = 5;
+    const std::size_t searchFields = names.size() * countStrategyFields;
+    std::vector<long long> sums(searchFields + 5, 0);
+    long long maxDepth = 0;
+    for (auto const &schedulers: strategySchedulers) {
+        for (auto const &scheduler: schedulers) {
+            for (auto const &strategy: scheduler.second.getStrategies()) {
+                const std::size_t index = std::find(names.begin(), names.end(), strategy.name) - names.begin();
+                long long *fields = sums.data() + index * countStrategyFields;
+                fields[0] += strategy.calls;
+                fields[1] += strategy.skips;
+                fields[2] += strategy.eliminations;
+                fields[3] += strategy.placements;
+                fields[4] += strategy.nanoseconds;
+            }
+        }
+    }
+    long long *allDifferentFields = sums.data() + (names.size() - 1) * countStrategyFields;
+    for (auto const &statistics: searchStatistics) {
+        allDifferentFields[0] += statistics.allDifferentCalls;
+        allDifferentFields[2] += statistics.allDifferentEliminations;
+        allDifferentFields[3] += statistics.allDifferentPlacements;
+        allDifferentFields[4] += statistics.allDifferentNanoseconds;
+        sums[searchFields] += statistics.nodes;
+        sums[searchFields + 1] += statistics.backtracks;
+        sums[searchFields + 2] += statistics.deadEnds;
+        maxDepth = std::max(maxDepth, statistics.maxDepth);
+    }
+    for (auto const &kernel: bitmaskKernels) {
+        sums[searchFields + 3] += kernel.getNodes();
+    }
+    sums[searchFields + 4] = searchStatistics.size();
+
+    long long maximums[2] = {maxDepth, getPeakResidentMemory()};
+
+    std::vector<long long> totals(sums.size(), 0);
+    long long totalMaximums[2] = {0, 0};
+    MPI_Reduce(sums.data(), totals.data(), sums.size(), MPI_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+    MPI_Reduce(maximums, totalMaximums, 2, MPI_LONG_LONG, MPI_MAX, 0, MPI_COMM_WORLD);
+    const long long totalMaxDepth = totalMaximums[0];
+    const long long peakMemory = totalMaximums[1];
+    if (processId != 0) {
+        return;
+    }
+    int countProcess;
+    MPI_Comm_size(MPI_COMM_WORLD, &countProcess);
+    long long const *search = totals.data() + searchFields;
+
+    if (STATS_OUTPUT == STATS_JSON) {
+        std::cout << "{\"processes\":" << countProcess << ",\"threads\":" << search[4] << ",\"search\":{\"nodes\":"
+                  << search[0] << ",\"backtracks\":" << search[1] << ",\"deadEnds\":" << search[2]
+                  << ",\"maxDepth\":" << totalMaxDepth << ",\"kernelNodes\":" << search[3] << "},\"peakMemoryKiB\":"
+                  << peakMemory << ",\"strategies\":[";
+        for (std::size_t i = 0; i < names.size(); ++i) {
+            long long const *fields = totals.data() + i * countStrategyFields;
+            std::cout << (i > 0 ? "," : "") << "{\"name\":\"" << names[i] << "\",\"calls\":" << fields[0]
+                      << ",\"skips\":" << fields[1] << ",\"eliminations\":" << fields[2] << ",\"placements\":"
+                      << fields[3] << ",\"nanoseconds\":" << fields[4] << "}";
+        }
+        std::cout << "]}" << std::endl;
+        return;
+    }
+
+    std::cout << "[" << processId << "]: statistics of " << countProcess << " processes and " << search[4]
+              << " threads :" << std::endl;
+    std::cout << std::setfill(' ') << std::left << std::setw(20) << "strategy" << std::right << std::setw(12)
+              << "calls" << std::setw(12) << "skips" << std::setw(14) << "eliminations" << std::setw(12)
+              << "placements" << std::setw(12) << "time [ms]" << std::setw(12) << "ns/call" << std::endl;
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        long long const *fields = totals.data() + i * countStrategyFields;
+        std::cout << std::left << std::setw(20) << names[i] << std::right << std::setw(12) << fields[0]
+                  << std::setw(12) << fields[1] << std::setw(14) << fields[2] << std::setw(12) << fields[3]
+                  << std::setw(12) << fields[4] / 1000000 << std::setw(12) << (fields[0] ? fields[4] / fields[0] : 0)
+                  << std::endl;
+    }
+    std::cout << "[" << processId << "]: " << search[0] << " search nodes, " << search[1] << " backtracks, "
+              << search[2] << " dead ends, max depth " << totalMaxDepth << ", " << search[3]
+              << " kernel nodes, peak memory of a process " << peakMemory / 1024 << " MiB." << std::endl;
+}
+
 int eliminatationStrategy(SudokuBoard &board) {
     // A cell has only one value left.
     const int solvedCellsBefore = board.getCountSolvedCells();
@@ -700,33 +3101,146 @@ int lonerangerStrategy(SudokuBoard &board) {
         }
     }
 
-    // reduce with lone ranger found
-    for (int i = 0; i < board.countRows(); ++i) {
-        for (int value = 1; value <= board.countRows(); ++value) {
-            // row
-            auto const &positionRow = rowsCellsValues[i][value];
-            if (positionRow.first >= 0 && positionRow.second >= 0) {
-                board.setValueAndUpdatePossibilities(positionRow.first, positionRow.second, value);
-                solvedCells += 1;
+    // reduce with lone ranger found
+    // a position saved above may have been filled by another lone ranger of this pass
+    auto setLoneRanger = [&board, &solvedCells](std::pair<int, int> const &position, int value) {
+        if (position.first < 0 || position.second < 0) {
+            return true;
+        }
+        if (board[position.first][position.second] == value) {
+            // already set using another unit
+            return true;
+        }
+        auto const &possibilitiesInCell = board.getPossiblesValuesInCells()[position.first][position.second];
+        if (board[position.first][position.second] != 0 ||
+            possibilitiesInCell.find(value) == possibilitiesInCell.end()) {
+            // the value is forced in two incompatible cells => dead-end
+            return false;
+        }
+        board.setValueAndUpdatePossibilities(position.first, position.second, value);
+        solvedCells += 1;
+        return true;
+    };
+    for (int i = 0; i < board.countRows(); ++i) {
+        for (int value = 1; value <= board.countRows(); ++value) {
+            if (!setLoneRanger(rowsCellsValues[i][value], value) ||
+                !setLoneRanger(columnsCellsValues[i][value], value) ||
+                !setLoneRanger(blocksCellsValues[i][value], value)) {
+                return -1;
+            }
+        }
+    }
+
+    return solvedCells - solvedCellsBefore;
+}
+
+int lockedCandidatesStrategy(SudokuBoard &board) {
+    // Pointing : in a block, a value only fits in one row (or column),
+    //            the value can be removed from the rest of the row (or column).
+    // Claiming : in a row (or column), a value only fits in one block,
+    //            the value can be removed from the rest of the block.
+    const int n = board.getSudokuDimension();
+    const int size = board.getBlockSize();
+    auto const &possiblesValuesInCells = board.getPossiblesValuesInCells();
+
+    // temp save where each value has been encountered, flatten as [unit * (size + 1) + value]
+    // -1 => not found, -2 => found in several lines/blocks
+    // blocksValuesRow[block][value] = row of the block containing the value
+    // blocksValuesCol[block][value] = column of the block containing the value
+    // rowsValuesBlock[row][value] = block of the row containing the value
+    // columnsValuesBlock[col][value] = block of the column containing the value
+    const int stride = size + 1;
+    std::vector<int> blocksValuesRow(size * stride, -1);
+    std::vector<int> blocksValuesCol(size * stride, -1);
+    std::vector<int> rowsValuesBlock(size * stride, -1);
+    std::vector<int> columnsValuesBlock(size * stride, -1);
+
+    auto saveEncounter = [](int &saved, int found) {
+        if (saved == -1) {
+            saved = found;
+        } else if (saved != found) {
+            saved = -2;
+        }
+    };
+
+    for (int row = 0; row < size; ++row) {
+        for (int col = 0; col < size; ++col) {
+            const int block = board.getBlockOfCell(row, col);
+            for (auto const possibleValue: possiblesValuesInCells[row][col]) {
+                saveEncounter(blocksValuesRow[block * stride + possibleValue], row);
+                saveEncounter(blocksValuesCol[block * stride + possibleValue], col);
+                saveEncounter(rowsValuesBlock[row * stride + possibleValue], block);
+                saveEncounter(columnsValuesBlock[col * stride + possibleValue], block);
+            }
+        }
+    }
+
+    int pointingEliminations = 0;
+    int claimingEliminations = 0;
+    for (int i = 0; i < size; ++i) {
+        const int blockRow = (i / n) * n;
+        const int blockCol = (i % n) * n;
+        for (int value = 1; value <= size; ++value) {
+            // pointing over a row : clear the row outside of the block
+            const int pointingRow = blocksValuesRow[i * stride + value];
+            if (pointingRow >= 0) {
+                for (int col = 0; col < size; ++col) {
+                    if (col < blockCol || col >= blockCol + n) {
+                        pointingEliminations += board.removePossibleValueForCell(pointingRow, col, value);
+                    }
+                }
+            }
+
+            // pointing over a column : clear the column outside of the block
+            const int pointingCol = blocksValuesCol[i * stride + value];
+            if (pointingCol >= 0) {
+                for (int row = 0; row < size; ++row) {
+                    if (row < blockRow || row >= blockRow + n) {
+                        pointingEliminations += board.removePossibleValueForCell(row, pointingCol, value);
+                    }
+                }
             }
 
-            // col
-            auto const &positionCol = columnsCellsValues[i][value];
-            if (positionCol.first >= 0 && positionCol.second >= 0) {
-                board.setValueAndUpdatePossibilities(positionCol.first, positionCol.second, value);
-                solvedCells += 1;
+            // claiming from the row i : clear the block outside of the row
+            const int claimingRowBlock = rowsValuesBlock[i * stride + value];
+            if (claimingRowBlock >= 0) {
+                const int initBlockRow = (claimingRowBlock / n) * n;
+                const int initBlockCol = (claimingRowBlock % n) * n;
+                for (int k = 0; k < n; ++k) {
+                    for (int p = 0; p < n; ++p) {
+                        if (initBlockRow + k != i) {
+                            claimingEliminations += board.removePossibleValueForCell(initBlockRow + k, initBlockCol + p,
+                                                                                     value);
+                        }
+                    }
+                }
             }
 
-            // block
-            auto const &positionBlock = blocksCellsValues[i][value];
-            if (positionBlock.first >= 0 && positionBlock.second >= 0) {
-                board.setValueAndUpdatePossibilities(positionBlock.first, positionBlock.second, value);
-                solvedCells += 1;
+            // claiming from the column i : clear the block outside of the column
+            const int claimingColBlock = columnsValuesBlock[i * stride + value];
+            if (claimingColBlock >= 0) {
+                const int initBlockRow = (claimingColBlock / n) * n;
+                const int initBlockCol = (claimingColBlock % n) * n;
+                for (int k = 0; k < n; ++k) {
+                    for (int p = 0; p < n; ++p) {
+                        if (initBlockCol + p != i) {
+                            claimingEliminations += board.removePossibleValueForCell(initBlockRow + k, initBlockCol + p,
+                                                                                     value);
+                        }
+                    }
+                }
             }
         }
     }
 
-    return solvedCells - solvedCellsBefore;
+#pragma omp atomic
+    lockedCandidatesCalls += 1;
+#pragma omp atomic
+    lockedCandidatesPointingHits += pointingEliminations;
+#pragma omp atomic
+    lockedCandidatesClaimingHits += claimingEliminations;
+
+    return pointingEliminations + claimingEliminations;
 }
 
 int twinsStrategy(SudokuBoard &board) {
@@ -772,11 +3286,6 @@ int npletStrategy(int n, SudokuBoard &board) {
         for (int col = 0; col < board.countColumns(); ++col) {
             auto const &possibilitiesInCell = board.getPossiblesValuesInCells()[row][col];
 
-            // skip when not enough possibilities
-            if (possibilitiesInCell.size() < n) {
-                continue;
-            }
-
             for (auto const possibleValue: possibilitiesInCell) {
                 // add current cell to saved positions
                 rowsCellsValues[row][possibleValue].emplace_back(std::pair<int, int>(row, col));
@@ -840,7 +3349,7 @@ int npletStrategy(int n, SudokuBoard &board) {
                     if (hasCellsToEliminate) {
                         for (int nplet = 0; nplet < n; ++nplet) {
                             auto const &cellCoords = rowsCellsValues[i][value][nplet];
-                            auto &cellPossibilities = board.getPossiblesValuesInCells()[cellCoords.first][cellCoords.second];
+                            auto &cellPossibilities = board.editPossiblesValuesInCell(cellCoords.first, cellCoords.second);
 
                             cellPossibilities.clear();
                             for (auto const &remainingValue: valuesOfSameCoords) {
@@ -906,7 +3415,7 @@ int npletStrategy(int n, SudokuBoard &board) {
                     if (hasCellsToEliminate) {
                         for (int nplet = 0; nplet < n; ++nplet) {
                             auto const &cellCoords = columnsCellsValues[i][value][nplet];
-                            auto &cellPossibilities = board.getPossiblesValuesInCells()[cellCoords.first][cellCoords.second];
+                            auto &cellPossibilities = board.editPossiblesValuesInCell(cellCoords.first, cellCoords.second);
 
                             cellPossibilities.clear();
                             for (auto const &remainingValue: valuesOfSameCoords) {
@@ -973,7 +3482,7 @@ int npletStrategy(int n, SudokuBoard &board) {
                     if (hasCellsToEliminate) {
                         for (int nplet = 0; nplet < n; ++nplet) {
                             auto const &cellCoords = blocksCellsValues[i][value][nplet];
-                            auto &cellPossibilities = board.getPossiblesValuesInCells()[cellCoords.first][cellCoords.second];
+                            auto &cellPossibilities = board.editPossiblesValuesInCell(cellCoords.first, cellCoords.second);
 
                             cellPossibilities.clear();
                             for (auto const &remainingValue: valuesOfSameCoords) {
@@ -996,6 +3505,339 @@ int npletStrategy(int n, SudokuBoard &board) {
     return modifiedCells;
 
 }
+bool isFishStrategyEnabled(int dimension) {
+    return FISH_MAX_SIZE >= 2 && dimension >= FISH_MIN_SUDOKU_DIMENSION && dimension * dimension <= SUDOKU_MASK_SIZE;
+}
+
+int configuredFishStrategy(SudokuBoard &board) {
+    return fishStrategy(FISH_MAX_SIZE, board);
+}
+
+int fishStrategy(int size, SudokuBoard &board) {
+    const int boardSize = board.getBlockSize();
+    auto const &possiblesValuesInCells = board.getPossiblesValuesInCells();
+
+    // bitboards of each value
+    // rowsBitboards[value][row] = columns of the row where the value is possible
+    // columnsBitboards[value][col] = rows of the column where the value is possible
+    std::vector<std::vector<SudokuMask>> rowsBitboards(boardSize + 1, std::vector<SudokuMask>(boardSize));
+    std::vector<std::vector<SudokuMask>> columnsBitboards(boardSize + 1, std::vector<SudokuMask>(boardSize));
+    for (int row = 0; row < boardSize; ++row) {
+        for (int col = 0; col < boardSize; ++col) {
+            for (auto const possibleValue: possiblesValuesInCells[row][col]) {
+                rowsBitboards[possibleValue][row].set(col);
+                columnsBitboards[possibleValue][col].set(row);
+            }
+        }
+    }
+
+    int eliminations = 0;
+    bool deadEnd = false;
+
+    // search fishes of the value over base lines (rows or columns), eliminate the value
+    // in the cover lines outside of the base lines
+    auto searchFish = [&](int value, int fishSize, bool rowsAsBase) {
+        auto const &lines = rowsAsBase ? rowsBitboards[value] : columnsBitboards[value];
+
+        // only lines with 2 to fishSize candidates can be part of the fish
+        std::vector<int> baseLines;
+        for (int line = 0; line < boardSize; ++line) {
+            const int count = (int) lines[line].count();
+            if (count >= 2 && count <= fishSize) {
+                baseLines.emplace_back(line);
+            }
+        }
+        if ((int) baseLines.size() < fishSize) {
+            return;
+        }
+
+        // enumerate combinations of fishSize base lines,
+        // a combination is dropped as soon as its cover is larger than fishSize
+        std::vector<std::pair<SudokuMask, SudokuMask>> fishes;
+        std::vector<int> chosen(fishSize, 0);
+        std::vector<SudokuMask> covers(fishSize + 1);
+        int depth = 0;
+        while (depth >= 0) {
+            if (chosen[depth] >= (int) baseLines.size()) {
+                depth -= 1;
+                if (depth >= 0) {
+                    chosen[depth] += 1;
+                }
+                continue;
+            }
+            covers[depth + 1] = covers[depth] | lines[baseLines[chosen[depth]]];
+            const int coverCount = (int) covers[depth + 1].count();
+            if (coverCount > fishSize) {
+                chosen[depth] += 1;
+                continue;
+            }
+            if (depth + 1 < fishSize) {
+                depth += 1;
+                chosen[depth] = chosen[depth - 1] + 1;
+                continue;
+            }
+
+            if (coverCount < fishSize) {
+                // fishSize lines sharing less than fishSize cover lines => dead-end
+                deadEnd = true;
+                return;
+            }
+            SudokuMask fishLines;
+            for (int k = 0; k < fishSize; ++k) {
+                fishLines.set(baseLines[chosen[k]]);
+            }
+            fishes.emplace_back(fishLines, covers[depth + 1]);
+            chosen[depth] += 1;
+        }
+
+        for (auto const &fish: fishes) {
+            for (int cover = 0; cover < boardSize; ++cover) {
+                if (!fish.second.test(cover)) {
+                    continue;
+                }
+                for (int line = 0; line < boardSize; ++line) {
+                    if (fish.first.test(line)) {
+                        continue;
+                    }
+                    const int row = rowsAsBase ? line : cover;
+                    const int col = rowsAsBase ? cover : line;
+                    if (board.removePossibleValueForCell(row, col, value)) {
+                        rowsBitboards[value][row].reset(col);
+                        columnsBitboards[value][col].reset(row);
+                        eliminations += 1;
+                    }
+                }
+            }
+        }
+    };
+
+    for (int value = 1; value <= boardSize && !deadEnd; ++value) {
+        for (int fishSize = 2; fishSize <= size && !deadEnd; ++fishSize) {
+            searchFish(value, fishSize, true);
+            if (!deadEnd) {
+                searchFish(value, fishSize, false);
+            }
+        }
+    }
+
+    return deadEnd ? -1 : eliminations;
+}
+bool isAllDifferentStrategyEnabled(SudokuBoard const &board) {
+    return ALL_DIFFERENT_MIN_SUDOKU_DIMENSION > 0 &&
+           board.getSudokuDimension() >= ALL_DIFFERENT_MIN_SUDOKU_DIMENSION;
+}
+
+int allDifferentStrategy(SudokuBoard &board) {
+    const int n = board.getSudokuDimension();
+    const int size = board.getBlockSize();
+    auto const &possiblesValuesInCells = board.getPossiblesValuesInCells();
+    auto &matchings = board.editAllDifferentMatchings();
+    if (matchings.size() != 3 * size * size) {
+        matchings.assign(3 * size * size, 0);
+    }
+
+    int eliminations = 0;
+
+    // graph of a unit : empty cells are the nodes [0, m), values are the nodes [m, m + size)
+    std::vector<std::pair<int, int>> unitCells;
+    std::vector<int> unitPositions;
+    std::vector<int> cellValue;
+    std::vector<int> valueCell(size + 1);
+    std::vector<bool> visitedValues(size + 1);
+
+    // augmenting path from a cell (Kuhn's algorithm)
+    std::function<bool(int)> augment = [&](int cell) {
+        for (auto const possibleValue: possiblesValuesInCells[unitCells[cell].first][unitCells[cell].second]) {
+            if (visitedValues[possibleValue]) {
+                continue;
+            }
+            visitedValues[possibleValue] = true;
+            if (valueCell[possibleValue] == -1 || augment(valueCell[possibleValue])) {
+                valueCell[possibleValue] = cell;
+                cellValue[cell] = possibleValue;
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // residual graph : cell -> matched value, value -> cells where it is possible but not matched
+    std::vector<std::vector<int>> valueCells(size + 1);
+    std::vector<int> component;
+    std::vector<int> lowLink;
+    std::vector<int> order;
+    std::vector<bool> onStack;
+    std::vector<int> stack;
+    int orderCounter = 0;
+    int componentCounter = 0;
+
+    auto successors = [&](int node, std::vector<int> &next) {
+        next.clear();
+        const int m = unitCells.size();
+        if (node < m) {
+            next.emplace_back(m + cellValue[node] - 1);
+        } else {
+            next = valueCells[node - m + 1];
+        }
+    };
+
+    // strongly connected components (Tarjan's algorithm)
+    std::function<void(int)> strongConnect = [&](int node) {
+        order[node] = lowLink[node] = orderCounter++;
+        stack.emplace_back(node);
+        onStack[node] = true;
+        std::vector<int> next;
+        successors(node, next);
+        for (int successor: next) {
+            if (order[successor] == -1) {
+                strongConnect(successor);
+                lowLink[node] = std::min(lowLink[node], lowLink[successor]);
+            } else if (onStack[successor]) {
+                lowLink[node] = std::min(lowLink[node], order[successor]);
+            }
+        }
+        if (lowLink[node] == order[node]) {
+            int member;
+            do {
+                member = stack.back();
+                stack.pop_back();
+                onStack[member] = false;
+                component[member] = componentCounter;
+            } while (member != node);
+            componentCounter += 1;
+        }
+    };
+
+    for (int unit = 0; unit < 3 * size; ++unit) {
+        unitCells.clear();
+        unitPositions.clear();
+        for (int position = 0; position < size; ++position) {
+            int row;
+            int col;
+            if (unit < size) {
+                row = unit;
+                col = position;
+            } else if (unit < 2 * size) {
+                row = position;
+                col = unit - size;
+            } else {
+                row = ((unit - 2 * size) / n) * n + position / n;
+                col = ((unit - 2 * size) % n) * n + position % n;
+            }
+            if (board[row][col] == 0) {
+                unitCells.emplace_back(row, col);
+                unitPositions.emplace_back(position);
+            }
+        }
+        const int m = unitCells.size();
+        if (m == 0) {
+            continue;
+        }
+
+        // restore the previous matching when still valid
+        int *unitMatching = matchings.data() + unit * size;
+        std::fill(valueCell.begin(), valueCell.end(), -1);
+        cellValue.assign(m, 0);
+        for (int cell = 0; cell < m; ++cell) {
+            const int value = unitMatching[unitPositions[cell]];
+            auto const &possibilitiesInCell = possiblesValuesInCells[unitCells[cell].first][unitCells[cell].second];
+            if (value > 0 && valueCell[value] == -1 && possibilitiesInCell.find(value) != possibilitiesInCell.end()) {
+                cellValue[cell] = value;
+                valueCell[value] = cell;
+            }
+        }
+        // then complete it
+        for (int cell = 0; cell < m; ++cell) {
+            if (cellValue[cell] == 0) {
+                std::fill(visitedValues.begin(), visitedValues.end(), false);
+                if (!augment(cell)) {
+                    // not enough values for the cells of the unit => dead-end
+                    return -1;
+                }
+            }
+        }
+        std::fill(unitMatching, unitMatching + size, 0);
+        for (int cell = 0; cell < m; ++cell) {
+            unitMatching[unitPositions[cell]] = cellValue[cell];
+        }
+
+        // build the residual graph
+        std::vector<bool> freeValues(size + 1, false);
+        for (int value = 1; value <= size; ++value) {
+            valueCells[value].clear();
+        }
+        for (int cell = 0; cell < m; ++cell) {
+            for (auto const possibleValue: possiblesValuesInCells[unitCells[cell].first][unitCells[cell].second]) {
+                if (possibleValue != cellValue[cell]) {
+                    valueCells[possibleValue].emplace_back(cell);
+                }
+                if (valueCell[possibleValue] == -1) {
+                    freeValues[possibleValue] = true;
+                }
+            }
+        }
+
+        // values reachable from a free value belong to an even alternating path
+        std::vector<bool> reachableValues(size + 1, false);
+        std::vector<int> toVisit;
+        for (int value = 1; value <= size; ++value) {
+            if (freeValues[value]) {
+                reachableValues[value] = true;
+                toVisit.emplace_back(value);
+            }
+        }
+        while (!toVisit.empty()) {
+            const int value = toVisit.back();
+            toVisit.pop_back();
+            for (int cell: valueCells[value]) {
+                const int matchedValue = cellValue[cell];
+                if (!reachableValues[matchedValue]) {
+                    reachableValues[matchedValue] = true;
+                    toVisit.emplace_back(matchedValue);
+                }
+            }
+        }
+
+        // values in the same component as the cell belong to an even alternating cycle
+        component.assign(m + size, -1);
+        lowLink.assign(m + size, 0);
+        order.assign(m + size, -1);
+        onStack.assign(m + size, false);
+        stack.clear();
+        orderCounter = 0;
+        componentCounter = 0;
+        for (int node = 0; node < m + size; ++node) {
+            if (order[node] == -1) {
+                strongConnect(node);
+            }
+        }
+
+        // remove values which can not be part of any maximum matching
+        for (int cell = 0; cell < m; ++cell) {
+            auto const &possibilitiesInCell = possiblesValuesInCells[unitCells[cell].first][unitCells[cell].second];
+            std::vector<int> removedValues;
+            for (int possibleValue: possibilitiesInCell) {
+                if (possibleValue != cellValue[cell] && !reachableValues[possibleValue] &&
+                    component[cell] != component[m + possibleValue - 1]) {
+                    removedValues.push_back(possibleValue);
+                }
+            }
+            // the row of the cell is only edited if a value is removed
+            for (int removedValue: removedValues) {
+                eliminations += board.removePossibleValueForCell(unitCells[cell].first, unitCells[cell].second,
+                                                                 removedValue);
+            }
+        }
+    }
+
+#pragma omp atomic
+    allDifferentCalls += 1;
+#pragma omp atomic
+    allDifferentHits += eliminations;
+
+    return eliminations;
+}
+
 // End of Solver methods
 
 SudokuBoard::SudokuBoard(int n) : arrAsLine(std::vector<int>(n * n * n * n)), n(n), rows(n * n), cols(n * n) {};
@@ -1082,6 +3924,12 @@ std::vector<int> SudokuBoard::SudokuRow::vector() const {
 }
 
 std::pair<int, int> SudokuBoard::nextEmptyCell() const {
+    if (isTrackingEmptyCells()) {
+        if (this->emptyCells.empty()) {
+            return {-1, -1};
+        }
+        return {this->emptyCells.front() / this->getRowSize(), this->emptyCells.front() % this->getRowSize()};
+    }
     for (int row = 0; row < this->getColumnSize(); row++) {
         for (int col = 0; col < this->getRowSize(); col++) {
             if (this->get(row, col) == 0) {
@@ -1102,6 +3950,26 @@ std::pair<int, int> SudokuBoard::nextEmptyCellComputed() const {
     }
     std::pair<int, int> lessPossibilitiesCell(-1, -1);
 
+    if (isTrackingEmptyCells()) {
+        // same cell as the scan below : the first one in row order among the cells with less possibilities
+        int lessPossibilitiesIndex = -1;
+        std::size_t lessPossibilities = 0;
+        for (int cell: this->emptyCells) {
+            const std::size_t countPossibilities =
+                    this->getPossiblesValuesInCells()[cell / this->getRowSize()][cell % this->getRowSize()].size();
+            if (lessPossibilitiesIndex == -1 || countPossibilities < lessPossibilities ||
+                (countPossibilities == lessPossibilities && cell < lessPossibilitiesIndex)) {
+                lessPossibilitiesIndex = cell;
+                lessPossibilities = countPossibilities;
+            }
+        }
+        if (lessPossibilitiesIndex != -1) {
+            lessPossibilitiesCell = {lessPossibilitiesIndex / this->getRowSize(),
+                                     lessPossibilitiesIndex % this->getRowSize()};
+        }
+        return lessPossibilitiesCell;
+    }
+
     for (int row = 0; row < this->getColumnSize(); row++) {
         for (int col = 0; col < this->getRowSize(); col++) {
             if (this->get(row, col) == 0) {
@@ -1146,38 +4014,81 @@ int SudokuBoard::getStartingColBlockOfCell(int col) const {
     return getBlockColOf(col) * this->n;
 }
 
-std::vector<std::vector<std::set<int>>> &SudokuBoard::getPossiblesValuesInCells() {
+CandidateGrid const &SudokuBoard::getPossiblesValuesInCells() const {
     return this->possiblesValuesInCells;
 }
 
-std::vector<std::vector<std::set<int>>> const &SudokuBoard::getPossiblesValuesInCells() const {
-    return this->possiblesValuesInCells;
+std::set<int> &SudokuBoard::editPossiblesValuesInCell(int row, int col) {
+    return this->possiblesValuesInCells.edit(row, col);
 }
 
-std::vector<std::set<int>> const &SudokuBoard::getPossiblesValuesInRows() const {
-    return this->possiblesValuesInRows;
+void CandidateGrid::assign(int countRows, int countColumns) {
+    this->rows.resize(countRows);
+    for (auto &row: this->rows) {
+        row = std::make_shared<std::vector<std::set<int>>>(countColumns);
+    }
 }
 
-std::vector<std::set<int>> &SudokuBoard::getPossiblesValuesInRows() {
-    return this->possiblesValuesInRows;
+int CandidateGrid::size() const {
+    return this->rows.size();
 }
 
-std::vector<std::set<int>> const &SudokuBoard::getPossiblesValuesInColumns() const {
-    return this->possiblesValuesInColumns;
+std::vector<std::set<int>> const &CandidateGrid::operator[](int row) const {
+    return *this->rows[row];
 }
 
-std::vector<std::set<int>> &SudokuBoard::getPossiblesValuesInColumns() {
-    return this->possiblesValuesInColumns;
+std::set<int> &CandidateGrid::edit(int row, int col) {
+    // the board owning the grid is only used by one thread, a row not shared can't become shared meanwhile
+    if (this->rows[row].use_count() > 1) {
+        this->rows[row] = std::make_shared<std::vector<std::set<int>>>(*this->rows[row]);
+    }
+    return (*this->rows[row])[col];
+}
 
+void UnitCandidates::assign(int countUnits) {
+    this->units.resize(countUnits);
+    for (auto &unit: this->units) {
+        unit = std::make_shared<std::set<int>>();
+    }
 }
 
-std::vector<std::set<int>> const &SudokuBoard::getPossiblesValuesInBlocks() const {
-    return this->possiblesValuesInBlocks;
+int UnitCandidates::size() const {
+    return this->units.size();
 }
 
-std::vector<std::set<int>> &SudokuBoard::getPossiblesValuesInBlocks() {
+std::set<int> const &UnitCandidates::operator[](int unit) const {
+    return *this->units[unit];
+}
+
+std::set<int> &UnitCandidates::edit(int unit) {
+    // the board owning the units is only used by one thread, a unit not shared can't become shared meanwhile
+    if (this->units[unit].use_count() > 1) {
+        this->units[unit] = std::make_shared<std::set<int>>(*this->units[unit]);
+    }
+    return *this->units[unit];
+}
+
+UnitCandidates const &SudokuBoard::getPossiblesValuesInRows() const {
+    return this->possiblesValuesInRows;
+}
+
+UnitCandidates const &SudokuBoard::getPossiblesValuesInColumns() const {
+    return this->possiblesValuesInColumns;
+}
+
+UnitCandidates const &SudokuBoard::getPossiblesValuesInBlocks() const {
     return this->possiblesValuesInBlocks;
 }
+
+std::vector<int> &SudokuBoard::editAllDifferentMatchings() {
+    // the board is only used by one thread, a matching not shared can't become shared meanwhile
+    if (!this->allDifferentMatchings) {
+        this->allDifferentMatchings = std::make_shared<std::vector<int>>();
+    } else if (this->allDifferentMatchings.use_count() > 1) {
+        this->allDifferentMatchings = std::make_shared<std::vector<int>>(*this->allDifferentMatchings);
+    }
+    return *this->allDifferentMatchings;
+}
 // End of data access methods
 
 // Copy data access methods
@@ -1211,45 +4122,101 @@ std::vector<int> SudokuBoard::getCopyBlock(int cellX, int cellY) const {
 // Begin data setters methods
 int SudokuBoard::recountSolvedCells() {
     this->countSolvedCells = 0;
-    for (auto const &e: arrAsLine) {
-        if (e != 0) {
+    this->zobristHash = 0;
+    this->emptyCells.clear();
+    this->emptyCellPositions.assign(arrAsLine.size(), -1);
+    for (int cell = 0; cell < (int) arrAsLine.size(); ++cell) {
+        if (arrAsLine[cell] != 0) {
             this->countSolvedCells += 1;
+            this->zobristHash ^= zobristKey(cell, arrAsLine[cell]);
+        } else {
+            this->emptyCellPositions[cell] = this->emptyCells.size();
+            this->emptyCells.push_back(cell);
         }
     }
     return this->countSolvedCells;
 }
 
+bool SudokuBoard::isTrackingEmptyCells() const {
+    return !this->emptyCellPositions.empty();
+}
+
+std::vector<int> const &SudokuBoard::getEmptyCells() const {
+    return this->emptyCells;
+}
+
+std::uint64_t SudokuBoard::getZobristHash() const {
+    return this->zobristHash;
+}
+
+double SudokuBoard::getCostEstimate() const {
+    return this->costEstimate;
+}
+
+void SudokuBoard::setCostEstimate(double costEstimate) {
+    this->costEstimate = costEstimate;
+}
+
 void SudokuBoard::computePossiblesValuesInCells() {
     this->computedPossibleValues = true;
-    this->possiblesValuesInCells.clear();
 
-    std::set<int> possiblesValues;
-    for (int i = 1; i <= this->getRowSize(); ++i) {
-        possiblesValues.insert(i);
+    // values used in each row, column and block, as bit masks : bit v is set if the value v is used
+    const int countValues = this->getBlockSize();
+    const int countWords = countValues / 64 + 1;
+    std::vector<std::uint64_t> usedInRows(countRows() * countWords, 0);
+    std::vector<std::uint64_t> usedInColumns(countColumns() * countWords, 0);
+    std::vector<std::uint64_t> usedInBlocks(countBlocks() * countWords, 0);
+    for (int row = 0; row < countRows(); ++row) {
+        for (int col = 0; col < countColumns(); ++col) {
+            const int value = this->get(row, col);
+            // values out of range can't prevent any candidate
+            if (value > 0 && value <= countValues) {
+                const std::uint64_t bit = 1ULL << (value % 64);
+                usedInRows[row * countWords + value / 64] |= bit;
+                usedInColumns[col * countWords + value / 64] |= bit;
+                usedInBlocks[getBlockOfCell(row, col) * countWords + value / 64] |= bit;
+            }
+        }
     }
 
-    this->possiblesValuesInColumns.resize(countColumns(), possiblesValues);
-    this->possiblesValuesInRows.resize(countRows(), possiblesValues);
-    this->possiblesValuesInBlocks.resize(countBlocks(), possiblesValues);
-    this->possiblesValuesInCells.resize(countRows(), std::vector<std::set<int>>(countColumns()));
+    // values not used in a unit
+    auto unusedValues = [countValues, countWords](std::uint64_t const *used) {
+        std::set<int> values;
+        for (int value = 1; value <= countValues; ++value) {
+            if (!(used[value / 64] & (1ULL << (value % 64)))) {
+                values.insert(values.end(), value);
+            }
+        }
+        return values;
+    };
+    this->possiblesValuesInRows.assign(countRows());
+    for (int row = 0; row < countRows(); ++row) {
+        this->possiblesValuesInRows.edit(row) = unusedValues(usedInRows.data() + row * countWords);
+    }
+    this->possiblesValuesInColumns.assign(countColumns());
+    for (int col = 0; col < countColumns(); ++col) {
+        this->possiblesValuesInColumns.edit(col) = unusedValues(usedInColumns.data() + col * countWords);
+    }
+    this->possiblesValuesInBlocks.assign(countBlocks());
+    for (int block = 0; block < countBlocks(); ++block) {
+        this->possiblesValuesInBlocks.edit(block) = unusedValues(usedInBlocks.data() + block * countWords);
+    }
 
+    // candidates of an empty cell are the values used in none of its units
+    this->possiblesValuesInCells.assign(countRows(), countColumns());
+#pragma omp parallel for schedule(static)
     for (int row = 0; row < countRows(); ++row) {
+        std::vector<std::uint64_t> used(countWords);
         for (int col = 0; col < countColumns(); ++col) {
-            const int value = this->get(row, col);
-            // value already set
-            if (value != 0) {
-                possiblesValuesInCells[row][col].clear();
-                possiblesValuesInBlocks[getBlockOfCell(row, col)].erase(value);
-                possiblesValuesInRows[row].erase(value);
-                possiblesValuesInColumns[col].erase(value);
-            } else {
-                // test with values
-                for (int valueTest = 1; valueTest <= getBlockSize(); ++valueTest) {
-                    if (testValueInCell(row, col, valueTest)) {
-                        this->possiblesValuesInCells[row][col].insert(valueTest);
-                    }
-                }
+            if (this->get(row, col) != 0) {
+                continue;
             }
+            const int block = getBlockOfCell(row, col);
+            for (int word = 0; word < countWords; ++word) {
+                used[word] = usedInRows[row * countWords + word] | usedInColumns[col * countWords + word] |
+                             usedInBlocks[block * countWords + word];
+            }
+            this->possiblesValuesInCells.edit(row, col) = unusedValues(used.data());
         }
     }
 }
@@ -1445,17 +4412,86 @@ bool SudokuBoard::checkNotDuplicatedCell(int row, int col) const {
 }
 
 bool SudokuBoard::checkIsValidConfig() const {
-    for (int row = 0; row < countRows(); ++row) {
-        for (int col = 0; col < countColumns(); ++col) {
-            if (this->get(row, col) != 0 && !checkNotDuplicatedCell(row, col)) {
-                return false;
+    BoardConflict conflict;
+    return !findFirstConflict(conflict);
+}
+
+bool SudokuBoard::findFirstConflict(BoardConflict &conflict) const {
+    const int countUnits = countRows();
+    const int countValues = getBlockSize();
+    const int countWords = countValues / 64 + 1;
+
+    // check a unit, (kind, unit) are numbered as kind * countUnits + unit
+    auto checkUnit = [this, countUnits, countValues, countWords](int ordinal, BoardConflict *found) {
+        const int kind = ordinal / countUnits;
+        const int unit = ordinal % countUnits;
+        const int n = getSudokuDimension();
+        std::vector<std::uint64_t> used(countWords, 0);
+        for (int i = 0; i < countUnits; ++i) {
+            int row = unit, col = i;
+            if (kind == CONFLICT_COLUMN) {
+                row = i;
+                col = unit;
+            } else if (kind == CONFLICT_BLOCK) {
+                row = (unit / n) * n + i / n;
+                col = (unit % n) * n + i % n;
             }
+            const int value = this->get(row, col);
+            bool conflicting;
+            if (kind == CONFLICT_VALUE_RANGE) {
+                conflicting = value < 0 || value > countValues;
+            } else if (value == 0) {
+                continue;
+            } else {
+                const std::uint64_t bit = 1ULL << (value % 64);
+                conflicting = (used[value / 64] & bit) != 0;
+                used[value / 64] |= bit;
+            }
+            if (conflicting) {
+                if (found != nullptr) {
+                    *found = {kind, unit, row, col, value};
+                }
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // first conflicting unit in [firstOrdinal, lastOrdinal), or lastOrdinal
+    auto findFirstConflictingUnit = [countUnits, &checkUnit](int firstOrdinal, int lastOrdinal) {
+        int firstConflict = lastOrdinal;
+#pragma omp parallel for schedule(static) reduction(min: firstConflict) if (countUnits >= VERIFY_PARALLEL_MIN_UNITS)
+        for (int ordinal = firstOrdinal; ordinal < lastOrdinal; ++ordinal) {
+            if (ordinal < firstConflict && checkUnit(ordinal, nullptr)) {
+                firstConflict = ordinal;
+            }
+        }
+        return firstConflict;
+    };
+
+    // values out of range are checked first, they don't fit in the masks
+    int firstConflict = findFirstConflictingUnit(CONFLICT_VALUE_RANGE * countUnits, (CONFLICT_VALUE_RANGE + 1) * countUnits);
+    if (firstConflict == (CONFLICT_VALUE_RANGE + 1) * countUnits) {
+        firstConflict = findFirstConflictingUnit(CONFLICT_ROW * countUnits, (CONFLICT_BLOCK + 1) * countUnits);
+        if (firstConflict == (CONFLICT_BLOCK + 1) * countUnits) {
+            return false;
         }
     }
-
+    checkUnit(firstConflict, &conflict);
     return true;
 }
 
+std::ostream &operator<<(std::ostream &os, const BoardConflict &conflict) {
+    if (conflict.kind == CONFLICT_VALUE_RANGE) {
+        return os << "value " << conflict.value << " out of range in cell (" << conflict.row << ", " << conflict.col
+                  << ")";
+    }
+    const char *unitName = conflict.kind == CONFLICT_ROW ? "row" : conflict.kind == CONFLICT_COLUMN ? "column"
+                                                                                                    : "block";
+    return os << "value " << conflict.value << " used twice in " << unitName << " " << conflict.unit
+              << ", again in cell (" << conflict.row << ", " << conflict.col << ")";
+}
+
 bool SudokuBoard::isComputedPossibleValues() const {
     return computedPossibleValues;
 }
@@ -1473,6 +4509,268 @@ void writeInFile(std::string const &fileName, std::string const &contentFile) {
 // End of format methods
 
 
+// Begin of trace methods
+/**
+ * Header of the trace files : magic, then version of the format and size of the records as 32 bits integers.
+ */
+static const char TRACE_MAGIC[] = "SDKTRACE";
+static const std::int32_t TRACE_VERSION = 1;
+
+void openTraceFiles(std::string const &prefix, int processId) {
+    const std::int32_t recordSize = sizeof(TraceRecord);
+    traceFiles.clear();
+    tracedSearches.assign(omp_get_max_threads(), 0);
+    for (int thread = 0; thread < omp_get_max_threads(); ++thread) {
+        std::stringstream fileName;
+        fileName << prefix << "." << processId << "." << thread << ".trace";
+        std::unique_ptr<std::ofstream> file(new std::ofstream(fileName.str(), std::ios::binary));
+        if (file->fail()) {
+            throw std::iostream::failure("Could not open trace file " + fileName.str() + ".");
+        }
+        file->write(TRACE_MAGIC, sizeof(TRACE_MAGIC) - 1);
+        file->write((char const *) &TRACE_VERSION, sizeof(TRACE_VERSION));
+        file->write((char const *) &recordSize, sizeof(recordSize));
+        file->flush();
+        traceFiles.emplace_back(std::move(file));
+    }
+}
+
+bool isTracing() {
+    return !traceFiles.empty();
+}
+
+int traceSearchRoot(SudokuBoard const &board) {
+    const int thread = omp_get_thread_num();
+    std::ofstream &file = *traceFiles.at(thread);
+    const int search = tracedSearches[thread]++;
+
+    // the candidates are written as computed by the search
+    SudokuBoard computedBoard(0);
+    if (!board.isComputedPossibleValues()) {
+        computedBoard = board;
+        computedBoard.computePossiblesValuesInCells();
+    }
+    SudokuBoard const &root = board.isComputedPossibleValues() ? board : computedBoard;
+
+    const TraceRecord record = {-1, root.getSudokuDimension(), 0, 0, TRACE_ROOT, 0, search};
+    file.write((char const *) &record, sizeof(record));
+    const int countWords = root.getBlockSize() / 64 + 1;
+    std::vector<std::int32_t> values(root.getSize());
+    std::vector<std::uint64_t> candidates(root.getSize() * countWords, 0);
+    for (int row = 0; row < root.getRowSize(); ++row) {
+        for (int col = 0; col < root.getColumnSize(); ++col) {
+            const int cell = row * root.getRowSize() + col;
+            values[cell] = root.get(row, col);
+            for (int value: root.getPossiblesValuesInCells()[row][col]) {
+                candidates[cell * countWords + value / 64] |= 1ULL << (value % 64);
+            }
+        }
+    }
+    file.write((char const *) values.data(), values.size() * sizeof(std::int32_t));
+    file.write((char const *) candidates.data(), candidates.size() * sizeof(std::uint64_t));
+    return search;
+}
+
+void traceSearchNode(TraceRecord const &record) {
+    traceFiles.at(omp_get_thread_num())->write((char const *) &record, sizeof(record));
+}
+
+void flushTraceFile() {
+    traceFiles.at(omp_get_thread_num())->flush();
+}
+
+void flushTraceFiles() {
+    for (auto &file: traceFiles) {
+        file->flush();
+    }
+}
+
+void replayTrace(std::string const &fileName, long long recordIndex) {
+    std::ifstream file(fileName, std::ios::binary);
+    if (file.fail()) {
+        throw std::iostream::failure("Could not open trace file " + fileName + ".");
+    }
+    char magic[sizeof(TRACE_MAGIC) - 1];
+    std::int32_t version = 0;
+    std::int32_t recordSize = 0;
+    file.read(magic, sizeof(magic));
+    file.read((char *) &version, sizeof(version));
+    file.read((char *) &recordSize, sizeof(recordSize));
+    if (!file || std::string(magic, sizeof(magic)) != TRACE_MAGIC || version != TRACE_VERSION ||
+        recordSize != sizeof(TraceRecord)) {
+        throw std::invalid_argument(fileName + " is not a trace file of this solver.");
+    }
+
+    // read the records, a process stopped in the middle of a write leaves a truncated record at the end
+    std::vector<TraceRecord> records;
+    std::map<int, SudokuBoard> roots;
+    TraceRecord record;
+    while (file.read((char *) &record, sizeof(record))) {
+        if (record.outcome == TRACE_ROOT) {
+            SudokuBoard root(record.value);
+            const int countWords = root.getBlockSize() / 64 + 1;
+            std::vector<std::int32_t> values(root.getSize());
+            std::vector<std::uint64_t> candidates(root.getSize() * countWords);
+            file.read((char *) values.data(), values.size() * sizeof(std::int32_t));
+            file.read((char *) candidates.data(), candidates.size() * sizeof(std::uint64_t));
+            if (!file) {
+                break;
+            }
+            std::copy(values.begin(), values.end(), root.data());
+            root.recountSolvedCells();
+            root.computePossiblesValuesInCells();
+            // the candidates removed before the search are removed again
+            for (int cell = 0; cell < root.getSize(); ++cell) {
+                for (int value = 1; value <= root.getBlockSize(); ++value) {
+                    if (!(candidates[cell * countWords + value / 64] & (1ULL << (value % 64)))) {
+                        root.removePossibleValueForCell(cell / root.getRowSize(), cell % root.getRowSize(), value);
+                    }
+                }
+            }
+            roots.erase(record.search);
+            roots.emplace(record.search, std::move(root));
+        }
+        records.push_back(record);
+    }
+
+    // subtree of each node : the following records of its search deeper than it, counted with prefix sums
+    std::vector<long long> subtreeNodes(records.size(), 0);
+    std::vector<long long> subtreeKernelNodes(records.size(), 0);
+    std::map<int, std::vector<std::size_t>> openNodes;
+    std::map<int, std::pair<long long, long long>> searchSums;
+    std::vector<std::pair<long long, long long>> sumsBefore(records.size());
+    std::vector<long long> countOutcomes(TRACE_ROOT + 1, 0);
+    long long kernelNodes = 0;
+    auto closeNodes = [&](int search, int depth) {
+        std::vector<std::size_t> &open = openNodes[search];
+        std::pair<long long, long long> const &sums = searchSums[search];
+        while (!open.empty() && records[open.back()].depth >= depth) {
+            subtreeNodes[open.back()] = sums.first - sumsBefore[open.back()].first;
+            subtreeKernelNodes[open.back()] = sums.second - sumsBefore[open.back()].second;
+            open.pop_back();
+        }
+    };
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        TraceRecord const &node = records[i];
+        countOutcomes.at(node.outcome) += 1;
+        if (node.outcome == TRACE_ROOT) {
+            continue;
+        }
+        kernelNodes += node.kernelNodes;
+        closeNodes(node.search, node.depth);
+        std::pair<long long, long long> &sums = searchSums[node.search];
+        sumsBefore[i] = sums;
+        sums.first += 1;
+        sums.second += node.kernelNodes;
+        openNodes[node.search].push_back(i);
+    }
+    for (auto const &open: openNodes) {
+        closeNodes(open.first, 0);
+    }
+
+    const long long countNodes = records.size() - countOutcomes[TRACE_ROOT];
+    std::cout << "Trace " << fileName << " : " << records.size() << " records, " << countOutcomes[TRACE_ROOT]
+              << " searches, " << countNodes << " search nodes (" << countOutcomes[SOLVER_SOLVED] << " solved, "
+              << countOutcomes[SOLVER_DEAD_END] << " dead ends, " << countOutcomes[SOLVER_OPEN] << " branched, "
+              << countOutcomes[SOLVER_CANCELLED] + countOutcomes[SOLVER_TIMEOUT] << " cancelled), "
+              << kernelNodes << " kernel nodes." << std::endl;
+
+    auto printNode = [&](std::size_t i) {
+        TraceRecord const &node = records[i];
+        std::cout << "  record " << i << " : search " << node.search << ", depth " << node.depth;
+        if (node.cell >= 0) {
+            const int rowSize = roots.at(node.search).getRowSize();
+            std::cout << ", cell (" << node.cell / rowSize << ", " << node.cell % rowSize << ") = " << node.value;
+        }
+        std::cout << ", " << getStatusName(node.outcome) << " after " << node.propagated
+                  << " cells propagated, subtree of " << subtreeNodes[i] << " search nodes and "
+                  << subtreeKernelNodes[i] << " kernel nodes." << std::endl;
+    };
+
+    // heaviest subtrees, the first nodes of the searches are the heaviest but the least informative
+    std::vector<std::size_t> heaviest;
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        if (records[i].outcome != TRACE_ROOT && roots.count(records[i].search)) {
+            heaviest.push_back(i);
+        }
+    }
+    auto isHeavier = [&](std::size_t a, std::size_t b) {
+        if ((records[a].depth > 0) != (records[b].depth > 0)) {
+            return records[a].depth > 0;
+        }
+        return subtreeNodes[a] + subtreeKernelNodes[a] > subtreeNodes[b] + subtreeKernelNodes[b];
+    };
+    const std::size_t countHeaviest = std::min(heaviest.size(), (std::size_t) 10);
+    std::partial_sort(heaviest.begin(), heaviest.begin() + countHeaviest, heaviest.end(), isHeavier);
+    std::cout << "Heaviest subtrees :" << std::endl;
+    for (std::size_t i = 0; i < countHeaviest; ++i) {
+        printNode(heaviest[i]);
+    }
+
+    if (recordIndex < 0) {
+        if (heaviest.empty()) {
+            std::cout << "No search node to replay." << std::endl;
+            return;
+        }
+        recordIndex = heaviest.front();
+    }
+    if (recordIndex >= (long long) records.size() || records[recordIndex].outcome == TRACE_ROOT ||
+        !roots.count(records[recordIndex].search)) {
+        throw std::invalid_argument("Record " + std::to_string(recordIndex) + " is not a search node of the trace.");
+    }
+
+    // path from the first node of the search : the last node met at each depth above the replayed one
+    TraceRecord const &target = records[recordIndex];
+    std::vector<std::size_t> path;
+    for (std::size_t i = 0; i < (std::size_t) recordIndex; ++i) {
+        if (records[i].search == target.search && records[i].outcome != TRACE_ROOT) {
+            path.resize(std::min((std::size_t) records[i].depth, path.size()));
+            path.push_back(i);
+        }
+    }
+    path.resize(target.depth);
+    path.push_back(recordIndex);
+
+    // re-drive the search along the path : set the decision, then propagate the nodes which have been branched
+    bool stopped = false;
+    SudokuBoard board = roots.at(target.search);
+    for (std::size_t i: path) {
+        TraceRecord const &node = records[i];
+        if (node.cell >= 0) {
+            board.setValueAndUpdatePossibilities(node.cell / board.getRowSize(), node.cell % board.getRowSize(),
+                                                 node.value);
+        }
+        if (i != (std::size_t) recordIndex && propagateBoard(board, stopped) != SOLVER_OPEN) {
+            throw std::invalid_argument("The path to record " + std::to_string(recordIndex) +
+                                        " does not match the propagation, replay with the options of the trace.");
+        }
+    }
+
+    std::cout << "Replaying :" << std::endl;
+    printNode(recordIndex);
+    if (DEBUG >= DEBUG_BASE) {
+        std::cout << board << std::endl;
+    }
+    long long kernelNodesBefore = 0;
+    for (auto const &kernel: bitmaskKernels) {
+        kernelNodesBefore += kernel.getNodes();
+    }
+    SolverContext context(stopped);
+    double replayTime = -omp_get_wtime();
+    const int status = solveBoard(board, context);
+    replayTime += omp_get_wtime();
+    long long kernelNodesAfter = 0;
+    for (auto const &kernel: bitmaskKernels) {
+        kernelNodesAfter += kernel.getNodes();
+    }
+    std::cout << std::fixed << "Replayed subtree : " << getStatusName(status) << " after " << context.nodes
+              << " search nodes and " << kernelNodesAfter - kernelNodesBefore << " kernel nodes in " << replayTime
+              << " seconds." << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+}
+// End of trace methods
+
+
 // Begin of MPI exchanges methods
 int receivePushBackDeque(std::deque<SudokuBoard> &dequeue, int src, int tag, MPI_Comm comm) {
     unsigned int len;
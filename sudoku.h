@@ -8,14 +8,195 @@
 #include <deque>
 #include <utility>
 #include <set>
+#include <map>
+#include <string>
+#include <bitset>
+#include <random>
+#include <cstdint>
+#include <atomic>
+#include <memory>
 #include <mpi.h>
 
 #define CUSTOM_MPI_SOLUTIONS_TAG            10
 #define CUSTOM_MPI_POSSIBILITIES_TAG            11
 #define CUSTOM_MPI_IDLE_TAG            12
 #define CUSTOM_MPI_STOP_WORK_TAG            13
+#define CUSTOM_MPI_PARTIAL_TAG            14
 #define CUSTOM_MPI_INVALID_SUDOKU_RETURNED            15
+#define CUSTOM_MPI_BUDGET_EXHAUSTED_RETURNED            16
+#define CUSTOM_MPI_REPORT_TAG            17
 
+/**
+ * Maximum number of values (N^2) handled by a SudokuMask.
+ */
+#define SUDOKU_MASK_SIZE            128
+
+/**
+ * Bit mask over the values (or the positions) of a row, column or block.
+ */
+typedef std::bitset<SUDOKU_MASK_SIZE> SudokuMask;
+
+/**
+ * Branching policies of solveBoard.
+ */
+#define BRANCHING_CELL            0
+#define BRANCHING_UNIT            1
+
+/**
+ * Value ordering policies of solveBoard.
+ */
+#define VALUE_ORDER_NATURAL            0
+#define VALUE_ORDER_LCV            1
+#define VALUE_ORDER_HISTORY            2
+
+/**
+ * Search modes of the workers : split the board in problems shared by the workers,
+ * or race differently seeded searches of the whole board.
+ */
+#define SEARCH_SPLIT            0
+#define SEARCH_PORTFOLIO            1
+
+/**
+ * Tables of boards proven without solution used by the search.
+ */
+#define TRANSPOSITION_OFF            0
+#define TRANSPOSITION_THREAD            1
+#define TRANSPOSITION_SHARED            2
+
+/**
+ * Traversals of the search trees by the worker threads.
+ */
+#define TREE_SEARCH_DFS            0
+#define TREE_SEARCH_LDS            1
+#define TREE_SEARCH_LDS_PARALLEL            2
+
+/**
+ * Policies of the frontier generation : breadth-first, or the largest board first
+ * with the estimate given by the count of empty cells or the log-product of the candidates counts.
+ */
+#define FRONTIER_FIFO            0
+#define FRONTIER_EMPTY_CELLS            1
+#define FRONTIER_LOG_PRODUCT            2
+
+/**
+ * Order of the problems dispatched to the workers and threads : generation order, or the longest
+ * expected first with the estimate given by the log-product of the candidates counts or by random probes.
+ */
+#define DISPATCH_ORDER_FIFO            0
+#define DISPATCH_ORDER_LOG_PRODUCT            1
+#define DISPATCH_ORDER_PROBE            2
+
+/**
+ * Kinds of conflicts reported by the verifier of a board : a value used twice in a row, a column
+ * or a block, or a value out of range.
+ */
+#define CONFLICT_ROW            0
+#define CONFLICT_COLUMN            1
+#define CONFLICT_BLOCK            2
+#define CONFLICT_VALUE_RANGE            3
+
+/**
+ * Status of a search or a propagation : a solution has been found, the explored tree has no solution,
+ * the search has been stopped by the flag of its context, the search paused at its node budget,
+ * or the propagation left a board to branch on.
+ */
+#define SOLVER_SOLVED            0
+#define SOLVER_DEAD_END            1
+#define SOLVER_CANCELLED            2
+#define SOLVER_TIMEOUT            3
+#define SOLVER_OPEN            4
+
+/**
+ * Budgets of a run : none exhausted, wall time, search nodes or peak resident memory.
+ */
+#define BUDGET_NONE            0
+#define BUDGET_TIME            1
+#define BUDGET_NODES            2
+#define BUDGET_MEMORY            3
+
+/**
+ * Output of the statistics of the run : none, a table or a JSON object printed by the master.
+ */
+#define STATS_OFF            0
+#define STATS_TABLE            1
+#define STATS_JSON            2
+
+/**
+ * Outcome of the trace records starting a search, the other records have a SOLVER_* outcome.
+ */
+#define TRACE_ROOT            5
+
+struct BoardConflict;
+
+/**
+ * Possible values of the cells of a board, stored by rows shared between the copies of the board :
+ * copying the grid only copies pointers to the rows, a row is copied when a cell of the row is edited
+ * while another grid shares it.
+ */
+class CandidateGrid {
+public:
+    /**
+     * Reset the grid to cells without possible values, in rows owned by this grid.
+     * @param countRows - count of rows
+     * @param countColumns - count of cells in each row
+     */
+    void assign(int countRows, int countColumns);
+
+    /**
+     * @return - count of rows
+     */
+    int size() const;
+
+    /**
+     * @param row - the row
+     * @return - possible values of the cells of the row, read only
+     */
+    std::vector<std::set<int>> const &operator[](int row) const;
+
+    /**
+     * @param row - row of the cell
+     * @param col - col of the cell
+     * @return - possible values of the cell to edit, its row is copied first if it is shared
+     */
+    std::set<int> &edit(int row, int col);
+
+private:
+    std::vector<std::shared_ptr<std::vector<std::set<int>>>> rows;
+};
+
+/**
+ * Possible values of the units (rows, columns or blocks) of a board, each unit shared between the copies of the board :
+ * copying the units only copies pointers to their values, a unit is copied when it is edited while another board
+ * shares it.
+ */
+class UnitCandidates {
+public:
+    /**
+     * Reset the units to units without possible values, owned by these units.
+     * @param countUnits - count of units
+     */
+    void assign(int countUnits);
+
+    /**
+     * @return - count of units
+     */
+    int size() const;
+
+    /**
+     * @param unit - the unit
+     * @return - possible values of the unit, read only
+     */
+    std::set<int> const &operator[](int unit) const;
+
+    /**
+     * @param unit - the unit
+     * @return - possible values of the unit to edit, copied first if they are shared
+     */
+    std::set<int> &edit(int unit);
+
+private:
+    std::vector<std::shared_ptr<std::set<int>>> units;
+};
 
 /**
  * SudokuBoard class represents a grid a the sudoku game.
@@ -47,21 +228,46 @@ private:
     bool computedPossibleValues = false;
 
     /**
-     * Store possibles values in each cell.
+     * Store possibles values in each cell, the rows are shared with the copies of the board until edited.
      */
-    std::vector<std::vector<std::set<int>>> possiblesValuesInCells;
+    CandidateGrid possiblesValuesInCells;
     /**
-    * Store possibles values in each row.
+    * Store possibles values in each row, the units are shared with the copies of the board until edited.
     */
-    std::vector<std::set<int>> possiblesValuesInRows;
+    UnitCandidates possiblesValuesInRows;
     /**
-    * Store possibles values in each column.
+    * Store possibles values in each column, the units are shared with the copies of the board until edited.
     */
-    std::vector<std::set<int>> possiblesValuesInColumns;
+    UnitCandidates possiblesValuesInColumns;
     /**
-    * Store possibles values in each block.
+    * Store possibles values in each block, the units are shared with the copies of the board until edited.
     */
-    std::vector<std::set<int>> possiblesValuesInBlocks;
+    UnitCandidates possiblesValuesInBlocks;
+
+    /**
+     * Matching between empty cells and values of each unit (rows, then columns, then blocks)
+     * saved by the all-different strategy : allDifferentMatchings[unit * N^2 + position] = value, 0 if none.
+     * Copies of the board share this matching until one of them edits it.
+     */
+    std::shared_ptr<std::vector<int>> allDifferentMatchings;
+
+    /**
+     * Zobrist hash of the values set in the grid, updated with each value set.
+     */
+    std::uint64_t zobristHash = 0;
+
+    /**
+     * Sparse set of the empty cells (row * N^2 + col), rebuilt by recountSolvedCells and updated with each value set :
+     * emptyCells lists the empty cells in no particular order, emptyCellPositions[cell] is the position of the cell
+     * in emptyCells or -1 if the cell has a value. Not tracked until recountSolvedCells is called.
+     */
+    std::vector<int> emptyCells;
+    std::vector<int> emptyCellPositions;
+
+    /**
+     * Estimate of the cost of the search of the board, used to order the frontier.
+     */
+    double costEstimate = 0;
 public:
     /**
      * SudokuBoard constructor.
@@ -160,60 +366,82 @@ public:
     void setCountSolvedCells(int countSolvedCells);
 
     /**
-     * Count how many cells in the board have a non null value and save it.
+     * Count how many cells in the board have a non null value and save it, the Zobrist hash and the set
+     * of the empty cells are also recomputed.
      * @return - how many cells in the board are solved.
      */
     int recountSolvedCells();
 
     /**
-     * Computes possibles values in each cell.
+     * @return - true if the empty cells are tracked, i.e. recountSolvedCells has been called
      */
-    void computePossiblesValuesInCells();
+    bool isTrackingEmptyCells() const;
 
     /**
-     * @return - true if a computation was done, false otherwise.
+     * @complexity - O(1)
+     * @return - the empty cells (row * N^2 + col) in no particular order, the board must track its empty cells
      */
-    bool isComputedPossibleValues() const;
+    std::vector<int> const &getEmptyCells() const;
 
     /**
-     * @return - mapping of each possible values in each cell.
+     * @return - Zobrist hash of the values set in the grid
      */
-    std::vector<std::vector<std::set<int>>> &getPossiblesValuesInCells();
+    std::uint64_t getZobristHash() const;
 
     /**
-     * @return - mapping of each possible values in each cell.
+     * @return - estimate of the cost of the search of the board
      */
-    std::vector<std::vector<std::set<int>>> const &getPossiblesValuesInCells() const;
+    double getCostEstimate() const;
 
     /**
-     * @return - mapping of each possible values in each row.
+     * @param costEstimate - estimate of the cost of the search of the board
      */
-    std::vector<std::set<int>> const &getPossiblesValuesInRows() const;
+    void setCostEstimate(double costEstimate);
 
     /**
-     * @return - mapping of each possible values in each row.
+     * Computes possibles values in each cell.
      */
-    std::vector<std::set<int>> &getPossiblesValuesInRows();
+    void computePossiblesValuesInCells();
 
     /**
-     * @return - mapping of each possible values in each column.
+     * @return - true if a computation was done, false otherwise.
+     */
+    bool isComputedPossibleValues() const;
+
+    /**
+     * @return - mapping of each possible values in each cell, read only.
+     */
+    CandidateGrid const &getPossiblesValuesInCells() const;
+
+    /**
+     * Edit the possible values of a cell, its row stops being shared with the copies of the board.
+     * Use removePossibleValueForCell to remove a value which may not be possible.
+     * @param row - row of the cell
+     * @param col - col of the cell
+     * @return - possible values of the cell
      */
-    std::vector<std::set<int>> const &getPossiblesValuesInColumns() const;
+    std::set<int> &editPossiblesValuesInCell(int row, int col);
+
+    /**
+     * @return - mapping of each possible values in each row.
+     */
+    UnitCandidates const &getPossiblesValuesInRows() const;
 
     /**
      * @return - mapping of each possible values in each column.
      */
-    std::vector<std::set<int>> &getPossiblesValuesInColumns();
+    UnitCandidates const &getPossiblesValuesInColumns() const;
 
     /**
      * @return - mapping of each possible values in each block.
      */
-    std::vector<std::set<int>> const &getPossiblesValuesInBlocks() const;
+    UnitCandidates const &getPossiblesValuesInBlocks() const;
 
     /**
-     * @return - mapping of each possible values in each block.
+     * @return - matching between empty cells and values of each unit saved by the all-different strategy to edit,
+     * it is copied first if it is shared with a copy of the board.
      */
-    std::vector<std::set<int>> &getPossiblesValuesInBlocks();
+    std::vector<int> &editAllDifferentMatchings();
 
     /**
      * Add a possible value for a given cell.
@@ -225,11 +453,12 @@ public:
     void addPossibleValueForCell(int row, int col, int value);
 
     /**
-     * Remove a possible value for a given cell.
+     * Remove a possible value for a given cell, the row of the cell is not copied if the value is not possible.
      * @param row - row of the cell
      * @param col - col of the cell
+     * @return - 1 if the value has been removed, 0 if it was not possible
      */
-    void removePossibleValueForCell(int row, int col, int value);
+    int removePossibleValueForCell(int row, int col, int value);
 
     /**
      * @return - true if the board is solved.
@@ -393,6 +622,16 @@ public:
      */
     bool checkIsValidConfig() const;
 
+    /**
+     * Verify the board in one pass over each unit with bit masks of the used values, the units are
+     * checked in parallel. The first conflict is the one of the first unit in the order : values out of range,
+     * rows, columns then blocks.
+     *
+     * @param conflict - set to the first conflict if any
+     * @return - true if the board has a conflict, false otherwise
+     */
+    bool findFirstConflict(BoardConflict &conflict) const;
+
     /**
      * @return - board as raw pointer to data
      */
@@ -421,9 +660,9 @@ public:
     std::string export_possibilities() const;
 
     /**
-     * @complexity - O(n) - worst case where n = N
-     * @return - x,y coordinates of the first empty cell found in the board
-     *           if the board is complete, {-1, -1} will be returned
+     * @complexity - O(1) if the board tracks its empty cells, O(n) - worst case where n = N otherwise
+     * @return - x,y coordinates of an empty cell of the board : the first one in row order if the empty cells
+     *           are not tracked, if the board is complete, {-1, -1} will be returned
      */
     std::pair<int, int> nextEmptyCell() const;
     std::pair<int, int> nextEmptyCellComputed() const;
@@ -556,121 +795,1063 @@ public:
 };
 
 /**
- * Create a SudokuBoard from a saved instance contained in a file.
- *
- * @param fileName - file containing SudokuBoard's data.
- * @return - SudokuBoard initiated from the File.
+ * A conflict found by the verifier of a board.
  */
-SudokuBoard createFromFile(std::string const &fileName);
+struct BoardConflict {
+    /**
+     * Kind of the conflict, one of the CONFLICT_* values.
+     */
+    int kind;
+    /**
+     * Index of the row, column or block.
+     */
+    int unit;
+    /**
+     * Cell of the second occurrence of the value, or of the value out of range.
+     */
+    int row;
+    int col;
+    int value;
 
-/**
- * Create a SudokuBoard from an stdin, the first element contains
- * the size of the SudokuBoard.
- *
- * @return - SudokuBoard initiated from the File.
- */
-SudokuBoard createFromStdin();
+    friend std::ostream &operator<<(std::ostream &os, const BoardConflict &conflict);
+};
 
 /**
- * Write in a File a given content.
- *
- * @param fileName - path of the file to write.
- * @param contentFile - content of the file to set.
+ * Result sink of a search : the solution is moved into the buffer of the context instead of being returned
+ * by value, the search only returns its status.
+ * A context is owned by one thread, the stop flag may be shared between threads.
  */
-void writeInFile(std::string const &fileName, std::string const &contentFile);
+struct SolverContext {
+    /**
+     * @param stop - a flag used to stop the search, set when a solution is found
+     */
+    explicit SolverContext(bool &stop);
 
-/**
- * Solve a given SudokuBoard.
- * This function is recursive, it should be started using default
- * row and col values (beginning of the board).
- *
- *
- * @param board - the board to solve
- * @param solutionFound - a flag used to stop recursion
- * @param row - (optional) the row of the cell to work on
- * @param col - (optional) the column of the cell to work on
- * @return - the solved board if solved or a SudokuBoard with a 0 size if not solved
- */
-SudokuBoard solveBoard(SudokuBoard &board, bool &solutionFound, int row = 0, int col = 0);
+    bool &stop;
+    /**
+     * The solved board once the status is SOLVER_SOLVED, a SudokuBoard with a 0 size before.
+     */
+    SudokuBoard solution;
+    /**
+     * Status of the last search, one of the SOLVER_* values.
+     */
+    int status;
+    /**
+     * Count of nodes explored and of dead-ends met by the searches of the context.
+     */
+    long long nodes;
+    long long deadEnds;
+};
 
 /**
- * Solve a given SudokuBoard using Crook's algorithm.
- *
- * @param board - the board to solve, will be set empty if the algorithm discovered a dead-end
- * @param solutionFound - a flag used to stop recursion
- * @return - the solved board if solved or a SudokuBoard with a 0 size if not solved
+ * Record of the binary trace of a search : a node explored by SearchStack, or the start of a search
+ * (outcome TRACE_ROOT, value is the dimension of the board, followed by the values of the cells
+ * and the candidates of each cell as bits of 32 bits words).
  */
-SudokuBoard solveReduceCrook(SudokuBoard &board, bool &solutionFound);
+struct TraceRecord {
+    /**
+     * Cell (row * N^2 + col) and value of the decision leading to the node, -1 and 0 for the first node of a search.
+     */
+    std::int32_t cell;
+    std::int32_t value;
+    /**
+     * Count of decisions from the first node of the search.
+     */
+    std::int32_t depth;
+    /**
+     * Count of cells set by the propagation of the node.
+     */
+    std::int32_t propagated;
+    /**
+     * Status of the expansion of the node, SOLVER_OPEN if the node has been branched.
+     */
+    std::int32_t outcome;
+    /**
+     * Count of nodes explored by the bitmask kernel if the node has been handed off to it.
+     */
+    std::int32_t kernelNodes;
+    /**
+     * Index of the search in the trace file, the searches of a thread may be interleaved.
+     */
+    std::int32_t search;
+};
 
 /**
- * Generate possibilities for the next empty cell of the front board to work.
- * If the board is complete, return the solution.
- * If the board is invalid, remove it.
- * Otherwise, generate a subproblem : each possible value in the cell will result in a new
- *            board to process.
- *
- * This function permits to prepare division of the work.
- *
- * @param boardsToWork - list of board to check.
- * @param solutions - list of possible boards solutions. If the board is valid, the board is added to solutions.
- * @return - the solved board if solved or a SudokuBoard with a 0 size if not solved
+ * A value to set in a cell.
  */
-SudokuBoard generatePossibilitiesNextCell(std::deque<SudokuBoard> &boardsToWork);
+struct CellAssignment {
+    int row;
+    int col;
+    int value;
+};
 
 /**
- * On the process node, divide problems in sub-problems and run them on different threads.
- *
- * @param problems - problems to solve
- * @return - the solved board if solved or a SudokuBoard with a 0 size if not solved
+ * Count of possible positions of each value in each row, column and block of a board.
  */
-SudokuBoard solveProblemsOnNode(std::deque<SudokuBoard> &problems);
+struct UnitsValuesCount {
+    /**
+     * Count possible positions of each value in the board.
+     * @param board - the board, possibles values must have been computed.
+     */
+    explicit UnitsValuesCount(SudokuBoard const &board);
 
-/**
- * Apply elimination strategy on the SudokuBoard.
- * @param board - the board.
- * @return - number of changed cells or -1 if the board is discovered as not valid.
- */
-int eliminatationStrategy(SudokuBoard &board);
+    /**
+     * Counts are stored as [unit * stride + value].
+     */
+    int stride;
+    std::vector<int> rows;
+    std::vector<int> columns;
+    std::vector<int> blocks;
+};
 
 /**
- * Apply lone ranger strategy on the SudokuBoard.
- * @param board - the board.
- * @return - number of changed cells or -1 if the board is discovered as not valid.
+ * A node of the search explored by SearchStack : its board after propagation
+ * and the alternatives of its branching.
  */
-int lonerangerStrategy(SudokuBoard &board);
+struct SearchFrame {
+    SearchFrame(SudokuBoard &&board, std::vector<CellAssignment> &&alternatives, std::uint64_t entryHash,
+                int discrepancies);
 
-/**
- * Apply twins strategy on the SudokuBoard.
- * @param board - the board.
- * @return - number of changed cells or -1 if the board is discovered as not valid.
- */
-int twinsStrategy(SudokuBoard &board);
+    SudokuBoard board;
+    std::vector<CellAssignment> alternatives;
+    /**
+     * Index of the next alternative to try.
+     */
+    std::size_t next;
+    /**
+     * Zobrist hash of the board before its propagation.
+     */
+    std::uint64_t entryHash;
+    /**
+     * Discrepancies left to the node in a limited discrepancy search.
+     */
+    int discrepancies;
+    /**
+     * False once some alternatives have been given away, the node can't be proven dead by this search.
+     */
+    bool complete;
+};
 
 /**
- * Apply triplets strategy on the SudokuBoard.
- * @param board - the board.
- * @return - number of changed cells or -1 if the board is discovered as not valid.
+ * SearchStack explores the search tree of a board in depth-first order with an explicit stack of decisions,
+ * boards of the nodes are stored on the heap instead of the call stack.
+ * The exploration can be paused after some nodes, and the untried alternatives can be given away to other workers.
  */
-int tripletsStrategy(SudokuBoard &board);
+class SearchStack {
+    std::vector<SearchFrame> frames;
+    /**
+     * Board to explore first, not propagated yet.
+     */
+    SudokuBoard root;
+    bool hasRoot;
+    long long exploredNodes = 0;
+    /**
+     * Maximum count of discrepancies (alternatives other than the first one) on a path, -1 for no limit.
+     */
+    int discrepancyLimit = -1;
+    /**
+     * True once some alternatives have not been explored because of the discrepancy limit.
+     */
+    bool discrepancyCut = false;
+    /**
+     * Index of the search in the trace file of the thread, -1 if not traced.
+     */
+    int traceSearch = -1;
 
-/**
- * Apply a n-plet strategy on the SudokuBoard.
- *
- * @param n - the n of plet
- * @param board - the board.
- * @return - number of changed cells or -1 if the board is discovered as not valid.
- */
-int npletStrategy(int n, SudokuBoard &board);
+    /**
+     * Propagate a node, then push its frame if it must be branched.
+     * @param node - board of the node
+     * @param solutionFound - a flag used to stop the search
+     * @param discrepancies - discrepancies left to the node
+     * @param record - the cells propagated and the kernel nodes are set in it
+     * @return - SOLVER_SOLVED if the node is solved, SOLVER_DEAD_END if it has no solution or the search is
+     *           stopped, SOLVER_CANCELLED if a budget is exhausted, SOLVER_OPEN if its frame has been pushed
+     */
+    int expand(SudokuBoard &node, bool &solutionFound, int discrepancies, TraceRecord &record);
 
-/**
- * Receive a std::dequeue<SudokuBoard> using MPI and push it at the end of the given queue.
- *
- * @complexity - O(n) where n = count received boards
- *
- * @param dequeue - the receiving queue
- * @param src - from
- * @param tag - MPI_TAG
- * @param comm - MPI_COM
+    /**
+     * Solve a node with the bitmask kernel of the thread instead of propagating and branching.
+     * @param node - board of the node
+     * @param solutionFound - a flag used to stop the search
+     * @param entryHash - Zobrist hash of the node before its propagation
+     * @param record - the kernel nodes are set in it
+     * @return - SOLVER_SOLVED if the node is solved, SOLVER_CANCELLED if a budget is exhausted,
+     *           SOLVER_DEAD_END otherwise
+     */
+    int handOffToKernel(SudokuBoard &node, bool &solutionFound, std::uint64_t entryHash, TraceRecord &record);
+
+    /**
+     * Record the last tried alternative of the top frame as a dead-end.
+     * @param solutionFound - a flag used to stop the search
+     */
+    void recordFailure(bool const &solutionFound);
+
+public:
+    /**
+     * @param board - the board to solve, possibles values must have been computed.
+     */
+    explicit SearchStack(SudokuBoard const &board);
+
+    /**
+     * Explore the search tree.
+     *
+     * @param context - the solution is moved in it, its status and counts are updated
+     * @param maxNodes - count of nodes to explore before pausing, negative to explore until the end
+     * @return - SOLVER_SOLVED, SOLVER_DEAD_END once the tree is explored, SOLVER_CANCELLED if stopped
+     *           by the flag of the context or SOLVER_TIMEOUT if paused after maxNodes nodes or stopped by
+     *           an exhausted budget, the flag of the context is then set to stop the other searches
+     */
+    int run(SolverContext &context, long long maxNodes);
+
+    /**
+     * Give away the untried alternatives of the shallowest node which has some, they won't be explored by this search.
+     *
+     * @param boards - boards of the alternatives are pushed back in it
+     * @return - count of boards given away
+     */
+    int split(std::deque<SudokuBoard> &boards);
+
+    /**
+     * @return - true if the whole search tree has been explored
+     */
+    bool isExhausted() const;
+
+    /**
+     * @return - count of nodes in the stack
+     */
+    std::size_t getDepth() const;
+
+    /**
+     * @return - count of nodes explored since the beginning of the search
+     */
+    long long getExploredNodes() const;
+
+    /**
+     * Limit the count of discrepancies on the explored paths, must be set before the search runs.
+     * @param limit - maximum count of alternatives other than the first one on a path, -1 for no limit
+     */
+    void setDiscrepancyLimit(int limit);
+
+    /**
+     * @return - true if some alternatives have not been explored because of the discrepancy limit
+     */
+    bool isDiscrepancyCut() const;
+};
+
+/**
+ * Minimal depth-first search over bit masks used near the leaves of the search : no strategy,
+ * the candidates of a cell are its candidates on the board minus the values used in its units.
+ * Buffers are kept between calls, a thread reuses its kernel without allocation.
+ */
+class BitmaskKernel {
+    int n = 0;
+    int size = 0;
+    /**
+     * Values of the grid in row order.
+     */
+    std::vector<int> grid;
+    /**
+     * Values used in each row, column and block.
+     */
+    std::vector<SudokuMask> rowsUsed;
+    std::vector<SudokuMask> columnsUsed;
+    std::vector<SudokuMask> blocksUsed;
+    /**
+     * Candidates of each cell on the board handed off.
+     */
+    std::vector<SudokuMask> candidates;
+    /**
+     * Empty cells, the cells before the current depth are set.
+     */
+    std::vector<int> emptyCells;
+    long long nodes = 0;
+    /**
+     * True once the search of the board handed off has been stopped by a budget or by the master.
+     */
+    bool cancelled = false;
+
+    /**
+     * Set the cell with less candidates among the empty cells from depth, then recurse.
+     * @param depth - count of empty cells set
+     * @param solutionFound - a flag used to stop the search
+     * @return - true if all the empty cells are set
+     */
+    bool search(std::size_t depth, bool const &solutionFound);
+
+public:
+    /**
+     * Solve a board.
+     * @param board - the board, possibles values must have been computed. Its empty cells are set if solved.
+     * @param solutionFound - a flag used to stop the search
+     * @return - true if the board is solved
+     */
+    bool solve(SudokuBoard &board, bool const &solutionFound);
+
+    /**
+     * @return - count of nodes explored by the kernel since its creation
+     */
+    long long getNodes() const;
+};
+
+/**
+ * Should the search hand off a board to the bitmask kernel ?
+ *
+ * @param board - the board
+ * @param stalled - true if the propagation of the node did not set any cell
+ * @return - true if the board has less empty cells than the kernel threshold percentage of its cells
+ *            (twice the percentage if stalled)
+ */
+bool isKernelHandoff(SudokuBoard const &board, bool stalled);
+
+/**
+ * Explore the paths of the search tree of a board with at most `limit` discrepancies,
+ * a discrepancy is a choice of an alternative other than the first one of the branching.
+ *
+ * @param board - the board to solve, possibles values must have been computed.
+ * @param limit - maximum count of discrepancies on a path
+ * @param context - the solution is moved in it
+ * @param exhausted - set to true if the whole search tree has been explored without solution
+ * @return - status of the search, one of the SOLVER_* values
+ */
+int solveWithDiscrepancies(SudokuBoard const &board, int limit, SolverContext &context, bool &exhausted);
+
+/**
+ * Limited discrepancy search : explore the search tree of a board with 0, 1, 2... discrepancies
+ * until a solution is found or the whole tree is explored.
+ *
+ * @param board - the board to solve, possibles values must have been computed.
+ * @param context - the solution is moved in it
+ * @return - status of the search, one of the SOLVER_* values
+ */
+int solveLimitedDiscrepancy(SudokuBoard const &board, SolverContext &context);
+
+/**
+ * Direct-mapped table of Zobrist hashes of boards proven without solution.
+ */
+class DeadStateTable {
+    std::vector<std::uint64_t> hashes;
+
+public:
+    /**
+     * @param bits - the table holds 2^bits hashes
+     */
+    explicit DeadStateTable(int bits);
+
+    /**
+     * @param hash - Zobrist hash of a board
+     * @return - true if the board is known without solution
+     */
+    bool contains(std::uint64_t hash) const;
+
+    /**
+     * Save a board without solution, replacing the board previously saved in the same slot.
+     * @param hash - Zobrist hash of the board
+     */
+    void insert(std::uint64_t hash);
+};
+
+/**
+ * Solutions counted by the threads of a process for the count mode, each thread increments its own counter
+ * padded on a cache line, the total is the sum of the counters.
+ */
+class SolutionCounter {
+    struct PaddedCount {
+        long long value;
+        char padding[64 - sizeof(long long)];
+    };
+
+    std::vector<PaddedCount> counts;
+    /**
+     * The count stops once the total reaches this limit.
+     */
+    long long limit;
+
+public:
+    /**
+     * @param limit - the count stops once the total reaches this limit
+     */
+    explicit SolutionCounter(long long limit);
+
+    /**
+     * Count a solution found by the current thread.
+     * @return - count of solutions found by the current thread
+     */
+    long long add();
+
+    /**
+     * @return - count of solutions found by all the threads
+     */
+    long long total() const;
+
+    /**
+     * @return - true if the limit is reached
+     */
+    bool isLimitReached() const;
+};
+
+/**
+ * Variant of the search run by a thread, a member of the portfolio is randomized :
+ * ties between cells with less possibilities and between alternatives are broken randomly,
+ * and its strategies are shuffled at each restart.
+ */
+struct SearchVariant {
+    bool randomized = false;
+    int valueOrder = VALUE_ORDER_NATURAL;
+    std::mt19937_64 random;
+};
+
+/**
+ * Statistics of the searches of a thread, counted when the statistics are enabled.
+ */
+struct SearchStatistics {
+    long long nodes = 0;
+    long long backtracks = 0;
+    long long deadEnds = 0;
+    /**
+     * Deepest node explored : count of decisions from the first node of its search.
+     */
+    long long maxDepth = 0;
+    /**
+     * The all-different filtering is applied out of the strategy schedulers.
+     */
+    long long allDifferentCalls = 0;
+    long long allDifferentEliminations = 0;
+    long long allDifferentPlacements = 0;
+    long long allDifferentNanoseconds = 0;
+};
+
+/**
+ * A strategy applied by solveReduceCrook and its runtime statistics.
+ */
+struct StrategyRecord {
+    /**
+     * StrategyRecord constructor.
+     * @param name - name of the strategy
+     * @param apply - the strategy, returns how many changes have been done or -1 for a dead-end
+     * @param pinned - a pinned strategy is always applied first and is never skipped
+     */
+    StrategyRecord(std::string name, int (*apply)(SudokuBoard &), bool pinned);
+
+    std::string name;
+    int (*apply)(SudokuBoard &);
+    bool pinned;
+
+    /**
+     * How many times the strategy has been applied or skipped.
+     */
+    long long calls = 0;
+    long long skips = 0;
+    /**
+     * Yield of the strategy : sum of changes done on the boards.
+     */
+    long long eliminations = 0;
+    /**
+     * Cost of the strategy : time spent in the strategy.
+     */
+    long long nanoseconds = 0;
+    /**
+     * Cells solved by the strategy, counted when the statistics are enabled.
+     */
+    long long placements = 0;
+
+    /**
+     * Count of consecutive calls without any change.
+     */
+    int failures = 0;
+    /**
+     * Backoff level, the strategy is skipped 2^backoff times after too many failures.
+     */
+    int backoff = 0;
+    int skipsRemaining = 0;
+};
+
+/**
+ * StrategyScheduler orders the strategies of solveReduceCrook for a size of board.
+ * Strategies producing nothing are skipped with an exponential backoff,
+ * strategies are periodically reordered by yield over cost.
+ * A scheduler is not thread safe, each thread uses its own schedulers (see getStrategyScheduler).
+ */
+class StrategyScheduler {
+private:
+    /**
+     * Dimension (N) of the boards handled by the scheduler.
+     */
+    int dimension;
+    /**
+     * Strategies in their order of application.
+     */
+    std::vector<StrategyRecord> strategies;
+    /**
+     * Count how many times the strategies have been applied.
+     */
+    long long passes = 0;
+
+    /**
+     * Sort not pinned strategies by eliminations per nanosecond.
+     */
+    void reorder();
+
+public:
+    /**
+     * StrategyScheduler constructor.
+     * @param dimension - dimension (N) of the boards handled by the scheduler
+     */
+    explicit StrategyScheduler(int dimension);
+
+    /**
+     * Apply the strategies in order until one of them changes the board.
+     * @param board - the board.
+     * @return - number of changes done by the strategy or -1 if the board is discovered as not valid,
+     *           0 if no strategy changed the board.
+     */
+    int applyStrategies(SudokuBoard &board);
+
+    /**
+     * @return - dimension (N) of the boards handled by the scheduler
+     */
+    int getDimension() const;
+
+    /**
+     * @return - strategies in their current order of application
+     */
+    std::vector<StrategyRecord> const &getStrategies() const;
+
+    /**
+     * Shuffle the order of not pinned strategies.
+     * @param random - random generator
+     */
+    void shuffle(std::mt19937_64 &random);
+};
+
+/**
+ * @param dimension - dimension (N) of the board
+ * @return - the strategy scheduler of the current thread for the given dimension
+ */
+StrategyScheduler &getStrategyScheduler(int dimension);
+
+/**
+ * Print the decisions and statistics of the strategy schedulers of the process.
+ * @param processId - rank of the process
+ */
+void printStrategySchedulers(int processId);
+
+/**
+ * Sum the statistics of the threads, then of the processes with MPI_Reduce, and print them on the master
+ * as a table or as JSON. Every process must call it.
+ * @param processId - rank of the process
+ */
+void reportStatistics(int processId);
+
+/**
+ * Check if the master asked the worker to stop its searches, the main thread receives the request.
+ * @return - true once the request has been received
+ */
+bool checkStopWork();
+
+/**
+ * Count the calling thread as done with its part of the searches of a parallel region, the main thread then
+ * keeps polling the stop requests of the master until the other threads of the team are done too.
+ * @param finishedThreads - count of the threads of the team done with their searches
+ */
+void finishSearchesPollingStopWork(int &finishedThreads);
+
+/**
+ * Poll the stop requests of the master from a task while tasks of the searches are unfinished, the task is
+ * created again until the main thread runs it. It sleeps only when no other task is waiting for the thread.
+ * @param queuedTasks - count of created tasks not started yet
+ * @param unfinishedTasks - count of created tasks of the searches not finished yet
+ */
+void pollStopWorkTask(int const &queuedTasks, int const &unfinishedTasks);
+
+/**
+ * Create a SudokuBoard from a saved instance contained in a file.
+ *
+ * @param fileName - file containing SudokuBoard's data.
+ * @return - SudokuBoard initiated from the File.
+ */
+SudokuBoard createFromFile(std::string const &fileName);
+
+/**
+ * Create a SudokuBoard from an stdin, the first element contains
+ * the size of the SudokuBoard.
+ *
+ * @return - SudokuBoard initiated from the File.
+ */
+SudokuBoard createFromStdin();
+
+/**
+ * Write in a File a given content.
+ *
+ * @param fileName - path of the file to write.
+ * @param contentFile - content of the file to set.
+ */
+void writeInFile(std::string const &fileName, std::string const &contentFile);
+
+/**
+ * Solve a given SudokuBoard.
+ * The search is driven by a SearchStack, each node applies the strategies on the board
+ * then branches over the alternatives given by computeBranchAlternatives.
+ *
+ *
+ * @param board - the board to solve
+ * @param context - the solution is moved in it
+ * @return - status of the search, one of the SOLVER_* values
+ */
+int solveBoard(SudokuBoard &board, SolverContext &context);
+
+/**
+ * @return - true if a time, node or memory budget has been given to the run
+ */
+bool isBudgetSet();
+
+/**
+ * Start the clock of the time budget.
+ */
+void startBudget();
+
+/**
+ * Check the budgets of the process, once a budget is exhausted it stays exhausted.
+ *
+ * @return - the exhausted budget, one of the BUDGET_* values, BUDGET_NONE if none is exhausted
+ */
+int checkBudget();
+
+/**
+ * @param status - a SOLVER_* status or TRACE_ROOT
+ * @return - name of the status
+ */
+std::string getStatusName(int status);
+
+/**
+ * @param budget - one of the BUDGET_* values
+ * @return - name of the budget, as given in its option
+ */
+std::string getBudgetName(int budget);
+
+/**
+ * @return - peak resident memory of the process in KiB
+ */
+long long getPeakResidentMemory();
+
+/**
+ * Keep the board if it has more solved cells than the best partial board of the process,
+ * only while a budget is set.
+ * @param board - a board after propagation
+ */
+void recordPartialBoard(SudokuBoard const &board);
+
+/**
+ * Open a trace file by thread, named prefix.processId.thread.trace
+ * @param prefix - prefix of the trace files
+ * @param processId - rank of the process
+ */
+void openTraceFiles(std::string const &prefix, int processId);
+
+/**
+ * @return - true if the searches of the process are traced
+ */
+bool isTracing();
+
+/**
+ * Write the start of a search in the trace file of the thread.
+ * @param board - first node of the search
+ * @return - index of the search in the trace file
+ */
+int traceSearchRoot(SudokuBoard const &board);
+
+/**
+ * Write a node of a search in the trace file of the thread.
+ * @param record - the node
+ */
+void traceSearchNode(TraceRecord const &record);
+
+/**
+ * Write the buffered records of the trace file of the thread.
+ */
+void flushTraceFile();
+
+/**
+ * Write the buffered records of the trace files of all the threads.
+ */
+void flushTraceFiles();
+
+/**
+ * Summarize a trace file and the heaviest subtrees it recorded, then re-drive the search along the recorded path
+ * to a node and solve the subtree of this node alone with solveBoard.
+ *
+ * @param fileName - the trace file
+ * @param recordIndex - index of the record of the node to replay, -1 for the heaviest subtree
+ */
+void replayTrace(std::string const &fileName, long long recordIndex);
+
+/**
+ * Key of a value in a cell for the Zobrist hash of the boards.
+ *
+ * @param cell - index of the cell (row * N^2 + col)
+ * @param value - value of the cell
+ * @return - the key
+ */
+std::uint64_t zobristKey(int cell, int value);
+
+/**
+ * Check if a board is known without solution, in the table of the current thread then in the shared table.
+ *
+ * @param hash - Zobrist hash of the board
+ * @return - true if the board is known without solution
+ */
+bool isKnownDeadState(std::uint64_t hash);
+
+/**
+ * Save a board proven without solution in the table of the current thread and in the shared table.
+ *
+ * @param hash - Zobrist hash of the board
+ */
+void recordDeadState(std::uint64_t hash);
+
+/**
+ * @return - search variant of the current thread
+ */
+SearchVariant &getSearchVariant();
+
+/**
+ * Find the empty cell with less possibilities, ties are broken randomly.
+ *
+ * @param board - the board, possibles values must have been computed.
+ * @param random - random generator
+ * @return - coordinates of the cell or {-1, -1} if the board is complete
+ */
+std::pair<int, int> nextEmptyCellRandomized(SudokuBoard const &board, std::mt19937_64 &random);
+
+/**
+ * Luby sequence : 1, 1, 2, 1, 1, 2, 4, 1, 1, 2, 1, 1, 2, 4, 8, ...
+ * @param i - index in the sequence, starting at 1
+ * @return - the i-th element of the sequence
+ */
+long long lubySequence(long long i);
+
+/**
+ * Race a portfolio of searches of the board, one by OpenMP thread. The first member is the default search,
+ * the others are randomized variants restarted after Luby sequence * PORTFOLIO_RESTART_BASE nodes.
+ * The first member finding a solution, or exhausting the search tree, stops the others.
+ *
+ * @param board - the board to solve, possibles values must have been computed.
+ * @param firstMember - index of the member run by the first thread, seeds its variant
+ * @param pollStopMessages - true if a stop message from the master process cancels the portfolio
+ * @param cancelled - set to true if the portfolio has been cancelled by the master process
+ * @return - the solved board if solved or a SudokuBoard with a 0 size if not solved
+ */
+SudokuBoard solvePortfolio(SudokuBoard const &board, int firstMember, bool pollStopMessages, bool &cancelled);
+
+/**
+ * Portfolio mode between MPI processes : the master sends the board to every worker, each of them runs
+ * a portfolio and the master stops them all once one of them found a solution or exhausted the search.
+ * A single process runs the portfolio itself.
+ *
+ * @param problemBoards - the board to solve on the master
+ * @param solutionBoards - the solution is pushed back in it by the process which found it
+ * @param successWorkerId - set to the process id which found the solution
+ * @param firstWinnerWorker - set to the process id which found the solution on this process
+ */
+void dispatchPortfolio(std::deque<SudokuBoard> &problemBoards, std::deque<SudokuBoard> &solutionBoards,
+                       int &successWorkerId, int &firstWinnerWorker);
+
+/**
+ * Propagate the constraints of a node of the search : strategies of solveReduceCrook,
+ * then all-different filtering on large boards.
+ *
+ * @param board - the board, will be set empty if a dead-end is discovered
+ * @param solutionFound - a flag used to stop the search
+ * @return - SOLVER_SOLVED, SOLVER_DEAD_END, SOLVER_CANCELLED or SOLVER_OPEN if the board must be branched
+ */
+int propagateBoard(SudokuBoard &board, bool const &solutionFound);
+
+/**
+ * Solve a problem board in an OpenMP task. While other tasks are waiting to be scheduled the search runs alone,
+ * otherwise idle threads are fed by splitting the search every SEARCH_SPLIT_PERIOD nodes.
+ * With a counter, the search goes on after a solution until the whole tree is explored or the limit is reached.
+ *
+ * @param board - the problem board
+ * @param solutionFound - a flag used to stop the search
+ * @param solutions - solutions found by the tasks, only the first one is kept when counting
+ * @param queuedTasks - count of created tasks not started yet
+ * @param unfinishedTasks - count of created tasks not finished yet
+ * @param counter - solutions counter of the count mode, nullptr to stop at the first solution
+ */
+void solveProblemTask(SudokuBoard const &board, bool &solutionFound, std::deque<SudokuBoard> &solutions,
+                      int &queuedTasks, int &unfinishedTasks, SolutionCounter *counter);
+
+/**
+ * Count a solution found by the search, after checking it.
+ *
+ * @param solution - the solved board
+ * @param solutionFound - a flag used to stop the search, set once the limit is reached
+ * @param solutions - the first counted solution is kept in it
+ * @param counter - solutions counter
+ */
+void countSolution(SudokuBoard &solution, bool &solutionFound, std::deque<SudokuBoard> &solutions,
+                   SolutionCounter &counter);
+
+/**
+ * Compute the alternatives to explore from a board.
+ * With the cell policy, each possible value of the cell with less possibilities is an alternative.
+ * With the unit policy, if a value has less possible positions in a row, a column or a block
+ * than the best cell, each position of the value in this unit is an alternative instead.
+ *
+ * @param board - the board, possibles values must have been computed.
+ * @return - alternatives to explore, empty if the board is complete or discovered as a dead-end.
+ */
+std::vector<CellAssignment> computeBranchAlternatives(SudokuBoard const &board);
+
+/**
+ * Order the alternatives of a branching using the configured value ordering :
+ * - natural : ascending values (or positions) order,
+ * - lcv : least constraining assignment first, the one removing less candidates from its peers,
+ * - history : assignment which led to less dead-ends in the thread first.
+ *
+ * @param board - the board
+ * @param counts - positions of the values in the units of the board, required by lcv
+ * @param alternatives - alternatives to order
+ */
+void orderBranchAlternatives(SudokuBoard const &board, UnitsValuesCount const *counts,
+                             std::vector<CellAssignment> &alternatives);
+
+/**
+ * @param board - a board of the search
+ * @return - dead-ends counters of the current thread used by the history value ordering
+ */
+std::vector<int> &getValueOrderHistory(SudokuBoard const &board);
+
+/**
+ * Record that an alternative of the search led to a dead-end, used by the history value ordering.
+ * @param board - the board where the alternative has been tried
+ * @param alternative - the alternative
+ */
+void recordFailedAlternative(SudokuBoard const &board, CellAssignment const &alternative);
+
+/**
+ * Solve a given SudokuBoard using Crook's algorithm.
+ *
+ * @param board - the board to solve, solved in place, will be set empty if the algorithm discovered a dead-end
+ *                or has been stopped by the flag or an exhausted budget
+ * @param solutionFound - a flag used to stop recursion
+ * @return - SOLVER_SOLVED, SOLVER_DEAD_END, SOLVER_CANCELLED or SOLVER_OPEN if the strategies are stalled
+ */
+int solveReduceCrook(SudokuBoard &board, bool const &solutionFound);
+
+/**
+ * Estimate the cost of the search of a board with the configured frontier policy.
+ *
+ * @param board - the board, possibles values must have been computed.
+ * @return - count of empty cells, or sum of log2 of the candidates counts of the empty cells
+ */
+double estimateFrontierCost(SudokuBoard const &board);
+
+/**
+ * Sum of log2 of the candidates counts of the empty cells : log2 of the size of the search space
+ * without propagation.
+ *
+ * @param board - the board, possibles values must have been computed.
+ * @return - log2 of the product of the candidates counts
+ */
+double logProductOfCandidates(SudokuBoard const &board);
+
+/**
+ * Knuth estimate of the size of the search tree of a board : random walks from the board to a leaf,
+ * each walk estimates the size of the tree as 1 + d1 + d1 * d2 + ... with di the count of alternatives
+ * at depth i. The walks do not apply the strategies, and are seeded by the hash of the board.
+ *
+ * @param board - the board, possibles values must have been computed.
+ * @param countProbes - how many random walks to average
+ * @return - log2 of the estimated count of nodes
+ */
+double probeSubtreeCost(SudokuBoard const &board, int countProbes);
+
+/**
+ * Estimate the cost of the search of a board with the configured dispatch order.
+ *
+ * @param board - the board, possibles values must have been computed.
+ * @return - log2 of the estimated size of the search tree
+ */
+double estimateSubtreeCost(SudokuBoard const &board);
+
+/**
+ * Attach their estimated cost to the boards and sort them longest expected first,
+ * does nothing with the fifo dispatch order.
+ *
+ * @param boards - boards to dispatch, their possibles values are computed if needed
+ */
+void orderByExpectedCost(std::deque<SudokuBoard> &boards);
+
+/**
+ * Compare the cost estimates of two boards, used to keep the best-first frontier as a heap.
+ *
+ * @param a - a board
+ * @param b - another board
+ * @return - true if the estimate of a is lower than the estimate of b
+ */
+bool hasLowerCostEstimate(SudokuBoard const &a, SudokuBoard const &b);
+
+/**
+ * Remove the next board to work from the frontier : the front board, or the largest one
+ * with a best-first frontier policy.
+ *
+ * @param boardsToWork - frontier, must not be empty
+ * @return - the removed board
+ */
+SudokuBoard popFrontierBoard(std::deque<SudokuBoard> &boardsToWork);
+
+/**
+ * Add a board to the frontier, at the back or in the heap with a best-first frontier policy.
+ *
+ * @param boardsToWork - frontier
+ * @param board - board to add
+ */
+void pushFrontierBoard(std::deque<SudokuBoard> &boardsToWork, SudokuBoard &&board);
+
+/**
+ * Reduce a board with the strategies, then split it on the values of its next empty cell.
+ *
+ * @param workingBoard - board to expand, reduced in place
+ * @param children - the boards created for each value of the cell are appended to it
+ * @return - SOLVER_SOLVED if the working board is solved, SOLVER_DEAD_END if it has no solution,
+ *           SOLVER_OPEN if it has been split
+ */
+int expandFrontierBoard(SudokuBoard &workingBoard, std::vector<SudokuBoard> &children);
+
+/**
+ * Generate possibilities for the next empty cell of the front board to work.
+ * If the board is complete, return the solution.
+ * If the board is invalid, remove it.
+ * Otherwise, generate a subproblem : each possible value in the cell will result in a new
+ *            board to process.
+ * With a best-first frontier policy, boards are kept as a heap and the board with the largest
+ * estimate is worked instead of the front board.
+ *
+ * This function permits to prepare division of the work.
+ *
+ * @param boardsToWork - list of board to check.
+ * @param solutions - list of possible boards solutions. If the board is valid, the board is added to solutions.
+ * @return - the solved board if solved or a SudokuBoard with a 0 size if not solved
+ */
+SudokuBoard generatePossibilitiesNextCell(std::deque<SudokuBoard> &boardsToWork);
+
+/**
+ * Expand several boards of the frontier at once, one by thread. The new boards are added to the frontier
+ * in the order of their parents, as generatePossibilitiesNextCell would.
+ *
+ * @param boardsToWork - list of board to check.
+ * @param countBoards - how many boards of the frontier to expand
+ * @return - the solved boards found among the expanded boards
+ */
+std::vector<SudokuBoard> generatePossibilitiesInParallel(std::deque<SudokuBoard> &boardsToWork, int countBoards);
+
+/**
+ * On the process node, divide problems in sub-problems and run them on different threads.
+ *
+ * @param problems - problems to solve
+ * @param counter - solutions counter of the count mode, nullptr to stop at the first solution
+ * @param context - the solution (the first counted one when counting) is moved in it
+ * @return - SOLVER_SOLVED if a solution has been found, SOLVER_DEAD_END otherwise
+ */
+int solveProblemsOnNode(std::deque<SudokuBoard> &problems, SolutionCounter *counter, SolverContext &context);
+
+/**
+ * Apply elimination strategy on the SudokuBoard.
+ * @param board - the board.
+ * @return - number of changed cells or -1 if the board is discovered as not valid.
+ */
+int eliminatationStrategy(SudokuBoard &board);
+
+/**
+ * Apply lone ranger strategy on the SudokuBoard.
+ * @param board - the board.
+ * @return - number of changed cells or -1 if the board is discovered as not valid.
+ */
+int lonerangerStrategy(SudokuBoard &board);
+
+/**
+ * Apply fish strategy on the SudokuBoard using the configured size.
+ * @param board - the board.
+ * @return - number of removed candidates or -1 if the board is discovered as not valid.
+ */
+int configuredFishStrategy(SudokuBoard &board);
+
+/**
+ * Apply locked candidates strategy on the SudokuBoard (pointing and claiming).
+ * A value confined to one row/column inside a block is removed from the rest of the row/column,
+ * a value confined to one block inside a row/column is removed from the rest of the block.
+ * @param board - the board.
+ * @return - number of removed candidates.
+ */
+int lockedCandidatesStrategy(SudokuBoard &board);
+
+/**
+ * Apply twins strategy on the SudokuBoard.
+ * @param board - the board.
+ * @return - number of changed cells or -1 if the board is discovered as not valid.
+ */
+int twinsStrategy(SudokuBoard &board);
+
+/**
+ * Apply triplets strategy on the SudokuBoard.
+ * @param board - the board.
+ * @return - number of changed cells or -1 if the board is discovered as not valid.
+ */
+int tripletsStrategy(SudokuBoard &board);
+
+/**
+ * @param dimension - dimension (N) of the boards.
+ * @return - true if the fish strategy should be applied on the boards : they are large enough
+ *           and their candidates fit in the bit masks.
+ */
+bool isFishStrategyEnabled(int dimension);
+
+/**
+ * Apply fish strategies (X-Wing, Swordfish, Jellyfish...) on the SudokuBoard, up to the given size.
+ * For a value, if k rows hold all their candidates for the value in the same k columns, the value
+ * is removed from the other cells of these columns (and the same with rows and columns swapped).
+ *
+ * @param size - the maximum size of the fish (2 = X-Wing, 3 = Swordfish, 4 = Jellyfish)
+ * @param board - the board.
+ * @return - number of removed candidates or -1 if the board is discovered as not valid.
+ */
+int fishStrategy(int size, SudokuBoard &board);
+
+/**
+ * @param board - the board.
+ * @return - true if the all-different strategy should be applied on the board.
+ */
+bool isAllDifferentStrategyEnabled(SudokuBoard const &board);
+
+/**
+ * Apply all-different filtering on each row, column and block of the SudokuBoard.
+ * A maximum matching between empty cells and values of the unit is maintained incrementally,
+ * then candidates that can not belong to any maximum matching are removed (Regin's filtering,
+ * using strongly connected components of the residual graph).
+ *
+ * @param board - the board.
+ * @return - number of removed candidates or -1 if the board is discovered as not valid.
+ */
+int allDifferentStrategy(SudokuBoard &board);
+
+/**
+ * Apply a n-plet strategy on the SudokuBoard.
+ *
+ * @param n - the n of plet
+ * @param board - the board.
+ * @return - number of changed cells or -1 if the board is discovered as not valid.
+ */
+int npletStrategy(int n, SudokuBoard &board);
+
+/**
+ * Receive a std::dequeue<SudokuBoard> using MPI and push it at the end of the given queue.
+ *
+ * @complexity - O(n) where n = count received boards
+ *
+ * @param dequeue - the receiving queue
+ * @param src - from
+ * @param tag - MPI_TAG
+ * @param comm - MPI_COM
  * @return - how many boards has been added to the dequeues
  */
 int receivePushBackDeque(std::deque<SudokuBoard> &dequeue, int src, int tag, MPI_Comm comm);
@@ -719,6 +1900,16 @@ SudokuBoard receiveSudokuBoard(int src, int tag, MPI_Comm pCommunicator);
 void initSolveMPI();
 
 
+/**
+ * Read the solver options given as `--name=value` arguments.
+ * Unknown options are reported and ignored.
+ *
+ * @param argc - count of arguments
+ * @param argv - arguments
+ * @param firstOption - index of the first argument to read
+ */
+void parseSolverOptions(int argc, char *argv[], int firstOption);
+
 /**
  * Function used for tests
  */